@@ -0,0 +1,26 @@
+#include "events.h"
+
+#include <debug.h>
+
+void event_queue_init(event_queue_t *q, game_event_t *slab, size_t capacity) {
+    q->items = slab;
+    q->capacity = capacity;
+    q->count = 0;
+    q->high_water = 0;
+}
+
+bool event_push(event_queue_t *q, uint8_t kind, int16_t amount, bloon_t *bloon,
+                tower_t *tower) {
+    if (q->count >= q->capacity) {
+        dbg_printf("event queue full (%d events)\n", (int)q->count);
+        return false;
+    }
+
+    game_event_t *ev = &q->items[q->count];
+    ev->kind = kind;
+    ev->amount = amount;
+    ev->bloon = bloon;
+    ev->tower = tower;
+    if (++q->count > q->high_water) q->high_water = q->count;
+    return true;
+}
@@ -0,0 +1,29 @@
+#ifndef EVENTS_H
+#define EVENTS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "structs.h"
+
+/// @brief Hand a slab of `capacity` events to the queue
+void event_queue_init(event_queue_t *q, game_event_t *slab, size_t capacity);
+
+/// @brief Record an event for the end of the tick
+/// @return `false` if there was no room and the event was dropped
+bool event_push(event_queue_t *q, uint8_t kind, int16_t amount, bloon_t *bloon,
+                tower_t *tower);
+
+/// @brief Forget every recorded event
+static inline void event_queue_clear(event_queue_t *q) { q->count = 0; }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
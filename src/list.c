@@ -3,6 +3,58 @@
 #include <debug.h>
 #include <stdlib.h>
 
+/* Slab of nodes handed over by list_pool_init; free nodes are chained through
+ * their `next` pointer */
+static list_ele_t *pool_slab = NULL;
+static list_ele_t *pool_free = NULL;
+static size_t pool_capacity = 0;
+static size_t pool_used = 0;
+static size_t pool_high_water = 0;
+
+void list_pool_init(list_ele_t *slab, size_t capacity) {
+    pool_slab = slab;
+    pool_capacity = (slab == NULL) ? 0 : capacity;
+    pool_free = NULL;
+    pool_used = 0;
+    pool_high_water = 0;
+
+    // chain every node onto the free list, lowest address first
+    for (size_t i = pool_capacity; i > 0; i--) {
+        pool_slab[i - 1].next = pool_free;
+        pool_free = &pool_slab[i - 1];
+    }
+}
+
+size_t list_pool_high_water(void) { return pool_high_water; }
+
+static inline bool node_in_pool(list_ele_t *elem) {
+    return elem >= pool_slab && elem < pool_slab + pool_capacity;
+}
+
+static list_ele_t *node_alloc(void) {
+    list_ele_t *elem = pool_free;
+    if (elem == NULL) {
+        // slab exhausted (or never provided): spill to the heap
+        dbg_printf("list pool empty, falling back to malloc\n");
+        return malloc(sizeof(list_ele_t));
+    }
+
+    pool_free = elem->next;
+    if (++pool_used > pool_high_water) pool_high_water = pool_used;
+    return elem;
+}
+
+static void node_free(list_ele_t *elem) {
+    if (!node_in_pool(elem)) {
+        free(elem);
+        return;
+    }
+
+    elem->next = pool_free;
+    pool_free = elem;
+    pool_used--;
+}
+
 queue_t *queue_new(void) {
     queue_t *q = malloc(sizeof(queue_t));
     if (q == NULL) {
@@ -25,7 +77,7 @@ void queue_free(queue_t *q, void (*freer)(void *)) {
 
         prev_elem = curr_elem;
         curr_elem = curr_elem->next;
-        free(prev_elem);
+        node_free(prev_elem);
     }
     free(q);
 }
@@ -39,7 +91,7 @@ size_t queue_size(queue_t *q) {
 void queue_insert_head(queue_t *q, void *v) {
     if (q == NULL) return;
 
-    list_ele_t *new_elem = malloc(sizeof(list_ele_t));
+    list_ele_t *new_elem = node_alloc();
     if (new_elem == NULL) {
         return;
     }
@@ -74,7 +126,7 @@ void queue_insert_head(queue_t *q, void *v) {
 void queue_insert_tail(queue_t *q, void *v) {
     if (q == NULL) return;
 
-    list_ele_t *new_elem = malloc(sizeof(list_ele_t));
+    list_ele_t *new_elem = node_alloc();
     if (new_elem == NULL) {
         return;
     }
@@ -121,7 +173,7 @@ void *queue_remove_head(queue_t *q) {
             void *to_ret = to_remove->value;
 
             q->head = q->tail = NULL;
-            free(to_remove);
+            node_free(to_remove);
             q->size--;
             return to_ret;
             break;
@@ -136,7 +188,7 @@ void *queue_remove_head(queue_t *q) {
             to_remove->next->prev = NULL;
             q->head = to_remove->next;
 
-            free(to_remove);
+            node_free(to_remove);
             q->size--;
             return to_ret;
             break;
@@ -162,7 +214,7 @@ void *queue_remove_tail(queue_t *q) {
             to_remove->prev->next = NULL;
             q->tail = to_remove->prev;
 
-            free(to_remove);
+            node_free(to_remove);
             q->size--;
             return to_ret;
             break;
@@ -191,6 +243,6 @@ void remove_and_delete(queue_t *q, list_ele_t *elem, void (*freer)(void *)) {
     elem->next->prev = elem->prev;
 
     if (freer != NULL) freer(elem->value);
-    free(elem);
+    node_free(elem);
     q->size--;
-}
\ No newline at end of file
+}
@@ -23,6 +23,17 @@ typedef struct {
 
 } queue_t;
 
+/// Node Pool
+
+/* Hand `list_ele_t` storage to the list module. Every insert draws a node from
+ * this slab through an O(1) free list and every removal returns it, so the
+ * game loop never touches the heap. If the slab runs dry (or was never
+ * provided) nodes fall back to malloc/free. */
+void list_pool_init(list_ele_t *slab, size_t capacity);
+
+/* Most slab nodes ever handed out at once (use this to size the slab). */
+size_t list_pool_high_water(void);
+
 /// Create / Destroy
 
 /* Create empty queue. */
@@ -9,6 +9,7 @@
 
 // standard libraries
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -29,23 +30,31 @@
 // our code
 #include "angle_lut.h"
 #include "bloons.h"
+#include "events.h"
 #include "freeplay.h"
 #include "list.h"
 #include "path.h"
 #include "save.h"
 #include "spacial_partition.h"
 #include "structs.h"
+#include "tower_heap.h"
 #include "towers.h"
 #include "utils.h"
+#include "wheel.h"
 
 #define SCREEN_WIDTH 320
 #define SCREEN_HEIGHT 240
 
 #define MAX_BLOONS      75  /* hard cap — children deferred and drip-fed back in */
+#define MAX_PROJECTILES 128  /* projectile store size; a volley that doesn't fit waits a tick */
 #define FREEZE_DURATION 30   /* frames bloon stays frozen (~0.5s) */
 #define SLOW_DURATION   90   /* frames bloon stays slowed */
 #define SLOW_FACTOR     2    /* speed divisor when glued */
+#define DOT_DURATION    180  /* frames a DoT keeps ticking (~3 seconds) */
 #define KEY_DELAY       8    /* frames between menu key repeats (~150ms) */
+#define TARGET_RESCAN   8    /* shots a tower reuses its First/Last target for before a full scan */
+#define TARGET_CHALLENGERS 4 /* bloons next to a reused target that get checked against it */
+#define TOWER_FIRE_BUDGET 8  /* towers that may fire in one tick; the rest go first next tick */
 
 /* Speed button position */
 #define SPEED_BTN_X (SCREEN_WIDTH - 10 - 32)
@@ -53,7 +62,41 @@
 #define SPEED_BTN_W 32
 #define SPEED_BTN_H 32
 
-#define SP_CELL_SIZE 40  /* spatial partition cell size (bigger = fewer boundary misses) */
+/* Grid lanes of a bloon: towers without camo detection only walk LANE_PLAIN */
+#define LANE_PLAIN 0
+#define LANE_CAMO  1
+
+/* Loop path bucket `k` (a size_t) over the buckets under a tower's range */
+#define TOWER_BUCKETS_FOR_EACH(track, tower, k)                                 \
+    for (uint8_t k##_s = 0; k##_s < (tower)->num_spans; k##_s++)                \
+        for (size_t k = path_bucket_of(track, (tower)->spans[k##_s].from),      \
+                    k##_hi = path_bucket_of(track, (tower)->spans[k##_s].to);   \
+             k <= k##_hi; k++)
+
+/* list_ele_t slab: bloons and projectiles link into the grid intrusively, so
+ * nodes only back the tower lists. A tower can be on towers, aura_towers and
+ * sleeping_towers at once, so there are three nodes for each of up to
+ * LIST_POOL_TOWERS towers before lists spill to malloc. */
+#define LIST_POOL_TOWERS 32
+#define LIST_POOL_NODES (LIST_POOL_TOWERS * 3)
+static list_ele_t list_pool_slab[LIST_POOL_NODES];
+
+/* Bloon store: popped bloons keep their slot until the end-of-tick compaction
+ * and pops at the cap still spawn (collapsed) children, so leave 2x headroom
+ * over the live cap. A full store just drops the spawn. */
+#define BLOON_POOL_SIZE (MAX_BLOONS * 3)
+
+#if BLOON_POOL_SIZE > 255
+#error "MAX_BLOONS is too large for a uint8_t bloon_t::track_slot"
+#endif
+static bloon_t bloon_slab[BLOON_POOL_SIZE];
+static projectile_t projectile_slab[MAX_PROJECTILES];
+
+/* Each bloon pops or leaks at most once a tick, so BLOON_POOL_SIZE events
+ * are never dropped */
+#define MAX_EVENTS BLOON_POOL_SIZE
+static game_event_t event_slab[MAX_EVENTS];
+
 /* Cursor acceleration: ramps from 2 to 6 px/frame over ~20 frames of holding */
 static uint8_t cursor_hold_frames = 0;
 
@@ -64,6 +107,10 @@ gfx_sprite_t* bloon_sprite_regrow_camo[NUM_BLOON_TYPES];
 gfx_sprite_t* tower_sprite_table[NUM_TOWER_TYPES];
 gfx_sprite_t* tower_projectile_table[NUM_TOWER_TYPES];
 
+/* How far any bloon's hitbox reaches from its center, so a collision query
+ * around a projectile also sees bloons centered in the neighbouring boxes */
+static uint8_t bloon_reach;
+
 /* Tower sprites all face DOWN in raw images (corrected by +128 in draw). */
 static const uint8_t tower_native_angle[NUM_TOWER_TYPES] = {
     192,  /* DART */
@@ -102,9 +149,175 @@ uint16_t adjusted_cost(uint16_t base) {
     return ((cost + 2) / 5) * 5;  /* Round to nearest $5 (wiki standard) */
 }
 
+/* ── Bloon Cell Summaries ────────────────────────────────────────────── */
+
+/* How far along the path a bloon is; higher is closer to the exit */
+static inline int path_rank(const bloon_t* bloon) {
+    return (int)bloon->dist;
+}
+
+/* bloon_type_t is an enum, so this can't be an #if */
+_Static_assert(NUM_BLOON_TYPES <= MAX_BLOON_TYPES,
+               "too many bloon types for tower_t::damage_vs and the uint16_t type masks");
+
+/* Work out what one of the tower's hits does to each bloon type (DMG_NORMAL
+ * ignores immunities; the MOAB multiplier only applies to MOABs), so a hit is
+ * a lookup in damage_vs instead of checking immunities and multipliers */
+static void fill_damage_table(tower_t* tower) {
+    tower->hit_types = 0;
+    for (uint8_t t = 0; t < NUM_BLOON_TYPES; t++) {
+        if (tower->damage_type != DMG_NORMAL && (BLOON_DATA[t].immunities & tower->damage_type)) {
+            tower->damage_vs[t] = -1;
+            continue;
+        }
+        tower->damage_vs[t] = tower->damage;
+        if (t == BLOON_MOAB) tower->damage_vs[t] *= tower->moab_damage_mult;
+        tower->hit_types |= (uint16_t)(1 << t);
+    }
+}
+
+/* Count a linked bloon into the summary of its box */
+static void cell_add(game_t* game, const bloon_t* bloon) {
+    bloon_cell_t* cell = &game->bloon_cells[bloon->link.box];
+    if (bloon->modifiers & MOD_CAMO) {
+        cell->camo++;
+    } else {
+        cell->plain++;
+    }
+    cell->types |= (uint16_t)(1 << bloon->type);
+}
+
+/* Does any bloon sit in the path buckets a tower's range covers? (Bloons
+ * popped since the last path_index_rebuild still count.) */
+static bool tower_range_empty(const path_index_t* track, const tower_t* tower) {
+    TOWER_BUCKETS_FOR_EACH(track, tower, k) {
+        if (track->start[(k + 1) * SP_LANES] != track->start[k * SP_LANES]) return false;
+    }
+    return true;
+}
+
+/* Take a tower that just came due off the schedule until a bloon enters its
+ * range's buckets; it must already be off the heap */
+static void sleepTower(game_t* game, tower_t* tower) {
+    TOWER_BUCKETS_FOR_EACH(&game->bloon_track, tower, k) {
+        game->tower_watch[k]++;
+    }
+    queue_insert_tail(game->sleeping_towers, tower);
+}
+
+/* A bloon just got into bucket `b`: put the towers sleeping on it back on the
+ * schedule, due when their cooldown would have come round anyway */
+static void wakeTowers(game_t* game, size_t b) {
+    if (game->tower_watch[b] == 0) return;
+
+    const path_index_t* track = &game->bloon_track;
+    list_ele_t* e = game->sleeping_towers->head;
+    while (e != NULL) {
+        list_ele_t* next = e->next;
+        tower_t* tower = (tower_t*)(e->value);
+
+        bool covers = false;
+        for (uint8_t i = 0; i < tower->num_spans && !covers; i++) {
+            covers = path_bucket_of(track, tower->spans[i].from) <= b &&
+                     b <= path_bucket_of(track, tower->spans[i].to);
+        }
+        if (covers) {
+            TOWER_BUCKETS_FOR_EACH(track, tower, k) {
+                game->tower_watch[k]--;
+            }
+            remove_and_delete(game->sleeping_towers, e, NULL);
+
+            uint16_t cooldown = tower->cooldown > 0 ? tower->cooldown : 1;
+            if (tower->next_fire < game->tick) {
+                uint24_t late = game->tick - tower->next_fire;
+                tower->next_fire += (late + cooldown - 1) / cooldown * cooldown;
+            }
+            tower_heap_push(&game->tower_schedule, tower);
+        }
+        e = next;
+    }
+}
+
+/* Link a bloon into the grid (in the lane for its camo flag) and its box
+ * summary */
+static void linkBloon(game_t* game, bloon_t* bloon) {
+    bloon->link.lane = (bloon->modifiers & MOD_CAMO) ? LANE_CAMO : LANE_PLAIN;
+    if (++game->bloon_serial == 0) game->bloon_serial = 1;
+    bloon->serial = game->bloon_serial;
+    sp_insert(game->bloons, bloon->position, &bloon->link);
+    cell_add(game, bloon);
+    wakeTowers(game, path_bucket_of(&game->bloon_track, bloon->dist));
+}
+
+/* Unlink a bloon from the grid; only the counts can be taken back out */
+static void unlinkBloon(game_t* game, bloon_t* bloon) {
+    if (!sp_linked(&bloon->link)) return;
+    wheel_cancel(&game->bloon_timers, &bloon->timer);
+    bloon_cell_t* cell = &game->bloon_cells[bloon->link.box];
+    if (bloon->modifiers & MOD_CAMO) {
+        cell->camo--;
+    } else {
+        cell->plain--;
+    }
+    sp_remove(game->bloons, &bloon->link);
+}
+
+/* Ticks an effect ending on `end` still has to run after the current one */
+static inline uint24_t ticks_left(const game_t* game, uint24_t end) {
+    return end > game->tick ? end - game->tick : 0;
+}
+
+static inline bloon_t* bloon_of_timer(timer_link_t* t) {
+    return (bloon_t*)((uint8_t*)t - offsetof(bloon_t, timer));
+}
+
+/* Put a bloon's timer on the wheel for the earliest thing it is waiting on,
+ * or take it off if there is nothing */
+static void schedule_bloon(game_t* game, bloon_t* bloon) {
+    uint24_t due = bloon->dot_next;
+    if (bloon->regrow_next != 0 && (due == 0 || bloon->regrow_next < due))
+        due = bloon->regrow_next;
+    if (bloon->frozen_by_permafrost && (due == 0 || bloon->freeze_end < due))
+        due = bloon->freeze_end;
+
+    if (due == 0) {
+        wheel_cancel(&game->bloon_timers, &bloon->timer);
+    } else if (due != bloon->timer.due) {
+        wheel_schedule(&game->bloon_timers, &bloon->timer, due);
+    }
+}
+
+/* sp_compact moved a bloon, so its timer's neighbours point at the old slot */
+static void bloon_moved(void* ctx, void* slot) {
+    game_t* game = ctx;
+    wheel_relink(&game->bloon_timers, &((bloon_t*)slot)->timer);
+}
+
+/* Start (or restart) damage-over-time: `damage` every `interval` ticks for
+ * DOT_DURATION ticks */
+static void start_dot(game_t* game, bloon_t* bloon, uint8_t damage,
+                      uint8_t interval) {
+    bloon->dot_damage = damage;
+    bloon->dot_interval = interval;
+    bloon->dot_left = interval > 0 ? DOT_DURATION / interval : 0;
+    bloon->dot_next = bloon->dot_left > 0 ? game->tick + interval : 0;
+    schedule_bloon(game, bloon);
+}
+
+/* Take `damage` off a bloon right away, so later hits this tick see it, and
+ * credit `tower` (if any) with `credit` pops. The pop is recorded once, when
+ * hp first runs out, and happens at the end of the tick. */
+static void damage_bloon(game_t* game, tower_t* tower, bloon_t* bloon,
+                         int16_t damage, int16_t credit) {
+    bool was_alive = bloon->hp > 0;
+    bloon->hp -= damage;
+    if (tower != NULL) tower->pop_count += credit;
+    if (was_alive && bloon->hp <= 0) event_push(&game->events, EVENT_POP, 0, bloon, tower);
+}
+
 /* ── Apply Upgrades ──────────────────────────────────────────────────── */
 
-void apply_upgrades(tower_t* tower) {
+void apply_upgrades(game_t* game, tower_t* tower) {
     const tower_data_t* base = &TOWER_DATA[tower->type];
 
     /* Start from base stats */
@@ -168,91 +381,165 @@ void apply_upgrades(tower_t* tower) {
         if (effective_frames < 2) effective_frames = 2;  /* minimum 2 frames */
     }
     tower->cooldown = (uint16_t)effective_frames;
+
+    /* Range and position only change on placement/upgrade, so the stretches
+     * of path the range covers are worked out here rather than on every scan */
+    tower->num_spans = (uint8_t)path_spans_in_circle(game->path, tower->position, tower->range,
+                                                     tower->spans, TOWER_MAX_SPANS);
+    fill_damage_table(tower);
 }
 
 /* ── Prediction & Targeting ──────────────────────────────────────────── */
 
 position_t predict_bloon_position(bloon_t* bloon, path_t* path) {
-    position_t predicted_pos = bloon->position;
-
-    if (bloon->segment < path->num_points - 1) {
-        position_t target = path->points[bloon->segment + 1];
-        int dx = target.x - bloon->position.x;
-        int dy = target.y - bloon->position.y;
-        int dist = abs(dx) + abs(dy);  // Manhattan distance (fast)
-
-        if (dist > 0) {
-            int speed = BLOON_DATA[bloon->type].speed_fp >> 8;
-            // Look ahead factor of 3
-            predicted_pos.x += (dx * speed * 3) / dist;
-            predicted_pos.y += (dy * speed * 3) / dist;
+    /* Look ahead three frames of movement, following the path round corners */
+    int24_t ahead = bloon->dist + 3 * (int24_t)BLOON_DATA[bloon->type].speed_fp;
+    uint16_t seg = path_segment_at(path, ahead, bloon->segment);
+    return path_point_at(path, seg, ahead);
+}
+
+/* First/Last: the track keeps every lane of a bucket sorted by distance, so
+ * walking in from the wanted end, the first bloon in range in each lane is
+ * that lane's pick and the first bucket with one holds the answer */
+static bloon_t* find_end_bloon(game_t* game, tower_t* tower, bool first) {
+    const path_index_t* track = &game->bloon_track;
+    int range_sq = (int)tower->range * (int)tower->range;
+    uint8_t lanes = tower->can_see_camo ? LANE_CAMO : LANE_PLAIN;
+
+    for (uint8_t s = 0; s < tower->num_spans; s++) {
+        const path_span_t* span = &tower->spans[first ? tower->num_spans - 1 - s : s];
+        size_t lo = path_bucket_of(track, span->from);
+        size_t hi = path_bucket_of(track, span->to);
+        for (size_t j = 0; j <= hi - lo; j++) {
+            size_t k = first ? hi - j : lo + j;
+            bloon_t* target = NULL;
+
+            for (uint8_t lane = 0; lane <= lanes; lane++) {
+                size_t begin = track->start[k * SP_LANES + lane];
+                size_t end = track->start[k * SP_LANES + lane + 1];
+                for (size_t i = 0; i < end - begin; i++) {
+                    bloon_t* bloon = track->order[first ? end - 1 - i : begin + i];
+                    if (!sp_linked(&bloon->link)) continue;
+
+                    int dx = bloon->position.x - tower->position.x;
+                    int dy = bloon->position.y - tower->position.y;
+                    if (dx * dx + dy * dy > range_sq) continue;
+
+                    if (target == NULL ||
+                        (first ? path_rank(bloon) > path_rank(target)
+                               : path_rank(bloon) < path_rank(target))) {
+                        target = bloon;
+                    }
+                    break;
+                }
+            }
+            if (target != NULL) return target;
         }
     }
+    return NULL;
+}
+
+/* The tower's cached target, if that slot still holds the same bloon and the
+ * tower could still pick it (linked, in a lane it sees, in range). Compaction
+ * moving the bloon to another slot just drops it from the cache. */
+static bloon_t* cached_target(game_t* game, const tower_t* tower) {
+    pool_t* pool = &game->bloon_pool;
+    if (tower->target_serial == 0 || tower->target_slot >= pool->count) return NULL;
+
+    bloon_t* bloon = pool_at(pool, tower->target_slot);
+    uint8_t lanes = tower->can_see_camo ? LANE_CAMO : LANE_PLAIN;
+    if (bloon->serial != tower->target_serial || !sp_linked(&bloon->link) ||
+        bloon->link.lane > lanes || bloon->track_slot == 0) {
+        return NULL;
+    }
+
+    int dx = bloon->position.x - tower->position.x;
+    int dy = bloon->position.y - tower->position.y;
+    if (dx * dx + dy * dy > (int)tower->range * (int)tower->range) return NULL;
+    return bloon;
+}
 
-    return predicted_pos;
+/* The few bloons next to `target` in track order (past it for First, before
+ * it for Last) are the ones most likely to have overtaken it; take the best
+ * of them that is in range */
+static bloon_t* challenge_target(game_t* game, const tower_t* tower,
+                                 bloon_t* target, bool first) {
+    const path_index_t* track = &game->bloon_track;
+    int range_sq = (int)tower->range * (int)tower->range;
+    uint8_t lanes = tower->can_see_camo ? LANE_CAMO : LANE_PLAIN;
+    size_t at = target->track_slot - 1;
+
+    for (size_t n = 1; n <= TARGET_CHALLENGERS; n++) {
+        if (first ? at + n >= track->count : n > at) break;
+        bloon_t* bloon = track->order[first ? at + n : at - n];
+        if (!sp_linked(&bloon->link) || bloon->link.lane > lanes) continue;
+
+        int dx = bloon->position.x - tower->position.x;
+        int dy = bloon->position.y - tower->position.y;
+        if (dx * dx + dy * dy > range_sq) continue;
+
+        if (first ? path_rank(bloon) > path_rank(target)
+                  : path_rank(bloon) < path_rank(target)) {
+            target = bloon;
+        }
+    }
+    return target;
 }
 
 bloon_t* find_target_bloon(game_t* game, tower_t* tower) {
+    if (tower->target_mode == TARGET_FIRST || tower->target_mode == TARGET_LAST) {
+        /* Bloons keep their order along the path from shot to shot, so last
+         * shot's target (or a neighbour that passed it) usually still wins.
+         * Every TARGET_RESCAN shots a full scan catches anything that didn't. */
+        bool first = tower->target_mode == TARGET_FIRST;
+        bloon_t* target = NULL;
+        if (tower->target_shots < TARGET_RESCAN) target = cached_target(game, tower);
+
+        if (target != NULL) {
+            target = challenge_target(game, tower, target, first);
+            tower->target_shots++;
+            game->target_reuses++;
+        } else {
+            target = find_end_bloon(game, tower, first);
+            tower->target_shots = 0;
+            game->target_scans++;
+        }
+
+        tower->target_serial = target != NULL ? target->serial : 0;
+        if (target != NULL) tower->target_slot = (uint8_t)pool_index(&game->bloon_pool, target);
+        return target;
+    }
+
     bloon_t* target = NULL;
     int range_sq = (int)tower->range * (int)tower->range;
     int best_val = 0;
     int best_dist_sq = 0;
     bool have_target = false;
 
-    list_ele_t* curr_box = game->bloons->inited_boxes->head;
-    while (curr_box != NULL) {
-        list_ele_t* curr_elem = ((queue_t*)(curr_box->value))->head;
-        while (curr_elem != NULL) {
-            bloon_t* bloon = (bloon_t*)(curr_elem->value);
-
-            /* Skip camo bloons if tower can't see camo */
-            if ((bloon->modifiers & MOD_CAMO) && !tower->can_see_camo) {
-                curr_elem = curr_elem->next;
-                continue;
-            }
-
+    /* Walk the path buckets under the range circle. Camo bloons are in the
+     * second lane, which is skipped if the tower can't see them. */
+    const path_index_t* track = &game->bloon_track;
+    uint8_t lanes = tower->can_see_camo ? LANE_CAMO : LANE_PLAIN;
+    TOWER_BUCKETS_FOR_EACH(track, tower, k) {
+        PATH_BUCKET_FOR_EACH(track, k, lanes, bloon) {
             int dx = bloon->position.x - tower->position.x;
             int dy = bloon->position.y - tower->position.y;
             int dist_sq = dx * dx + dy * dy;
 
             if (dist_sq <= range_sq) {
                 bool better = false;
-                switch (tower->target_mode) {
-                    case TARGET_FIRST: {
-                        /* Furthest along path (highest segment, then highest progress) */
-                        int val = (int)bloon->segment * 1000 + (int)(bloon->progress >> 4);
-                        if (!have_target || val > best_val) {
-                            best_val = val;
-                            better = true;
-                        }
-                        break;
-                    }
-                    case TARGET_LAST: {
-                        /* Least along path */
-                        int val = (int)bloon->segment * 1000 + (int)(bloon->progress >> 4);
-                        if (!have_target || val < best_val) {
-                            best_val = val;
-                            better = true;
-                        }
-                        break;
+                if (tower->target_mode == TARGET_STRONG) {
+                    /* Highest RBE in range */
+                    int val = (int)BLOON_DATA[bloon->type].rbe;
+                    if (!have_target || val > best_val) {
+                        best_val = val;
+                        better = true;
                     }
-                    case TARGET_STRONG: {
-                        /* Highest RBE in range */
-                        int val = (int)BLOON_DATA[bloon->type].rbe;
-                        if (!have_target || val > best_val) {
-                            best_val = val;
-                            better = true;
-                        }
-                        break;
-                    }
-                    case TARGET_CLOSE:
-                    default: {
-                        /* Closest distance to tower */
-                        if (!have_target || dist_sq < best_dist_sq) {
-                            best_dist_sq = dist_sq;
-                            better = true;
-                        }
-                        break;
+                } else {
+                    /* Closest distance to tower */
+                    if (!have_target || dist_sq < best_dist_sq) {
+                        best_dist_sq = dist_sq;
+                        better = true;
                     }
                 }
                 if (better) {
@@ -260,10 +547,7 @@ bloon_t* find_target_bloon(game_t* game, tower_t* tower) {
                     have_target = true;
                 }
             }
-
-            curr_elem = curr_elem->next;
         }
-        curr_box = curr_box->next;
     }
 
     return target;
@@ -291,54 +575,70 @@ tower_t* initTower(game_t* game, uint8_t type) {
     tower->total_invested = adjusted_cost(TOWER_DATA[type].cost);
     tower->pop_count = 0;
     tower->facing_angle = 0;
-    tower->tick = 0;
 
-    apply_upgrades(tower);
+    apply_upgrades(game, tower);
     return tower;
 }
 
 bloon_t* initBloon(game_t* game, uint8_t type, uint8_t modifiers) {
-    bloon_t* bloon = safe_malloc(sizeof(bloon_t), __LINE__);
-    memset(bloon, 0, sizeof(bloon_t));
+    bloon_t* bloon = pool_claim(&game->bloon_pool);
+    if (!bloon) return NULL;
     bloon->type = type;
     bloon->modifiers = modifiers;
     bloon->hp = BLOON_DATA[type].hp;
     bloon->regrow_max = (modifiers & MOD_REGROW) ? type : 0;
-    bloon->regrow_timer = REGROW_INTERVAL;
-    bloon->position.x = 0 - 16;  // start offscreen
-    bloon->position.y = game->path->points[0].y;
+    bloon->dist = -(PATH_SPAWN_OFFSET << 8);  // start offscreen, before the first point
+    bloon->position = path_point_at(game->path, 0, bloon->dist);
+    bloon->next_cross = path_next_crossing(game->path, bloon->dist);
     return bloon;
 }
 
-projectile_t* initProjectile(game_t* game, tower_t* tower, uint8_t angle) {
-    projectile_t* projectile = safe_malloc(sizeof(projectile_t), __LINE__);
-    memset(projectile, 0, sizeof(projectile_t));
+/* Claim a projectile slot for `tower` and link it into the grid. Everything
+ * that doesn't change in flight is read back through the owner. */
+projectile_t* fireProjectile(game_t* game, tower_t* tower, uint8_t angle) {
+    projectile_t* projectile = pool_claim(&game->projectile_pool);
+    if (!projectile) return NULL;
 
-    projectile->position.x = tower->position.x;
-    projectile->position.y = tower->position.y;
-    projectile->speed = tower->projectile_speed;
-    projectile->pierce = tower->pierce;
-    projectile->damage = tower->damage;
-    projectile->damage_type = tower->damage_type;
-    projectile->sprite = tower_projectile_table[tower->type];
+    projectile->position = tower->position;
+    projectile->from = tower->position;
+    projectile->owner = tower;
     projectile->angle = angle;
+    projectile->pierce = tower->pierce;
     projectile->lifetime = 120;  /* ~2 seconds at 60fps, despawn after */
-    projectile->owner = (void*)tower;
-
-    /* Carry ability fields from tower */
-    projectile->splash_radius = tower->splash_radius;
-    projectile->is_homing = tower->is_homing;
-    projectile->stun_duration = tower->stun_on_hit;
-    projectile->can_see_camo = tower->can_see_camo;
-    projectile->dot_damage = tower->dot_damage;
-    projectile->dot_interval = tower->dot_interval;
-    projectile->glue_soak = tower->glue_soak;
-    projectile->strips_camo = tower->strips_camo;
-
-    (void)game;
+
+    sp_insert(game->projectiles, projectile->position, &projectile->link);
     return projectile;
 }
 
+/* Drop every in-flight projectile fired by `tower` (before it is freed) */
+void despawnProjectiles(game_t* game, tower_t* tower) {
+    pool_t* pool = &game->projectile_pool;
+    for (size_t i = 0; i < pool->count; i++) {
+        projectile_t* proj = pool_at(pool, i);
+        if (proj->owner == tower) sp_remove(game->projectiles, &proj->link);
+    }
+    sp_compact(game->projectiles, pool);
+}
+
+/* Towers were placed, sold, upgraded or loaded: rebuild the fire schedule and
+ * the aura list, with every tower awake. A tower that was never scheduled
+ * gets its first shot at a random point within one cooldown, so towers
+ * loaded together don't all fire on the same ticks. */
+void towersChanged(game_t* game) {
+    while (queue_remove_head(game->aura_towers) != NULL) {
+    }
+    while (queue_remove_head(game->sleeping_towers) != NULL) {
+    }
+    memset(game->tower_watch, 0, game->bloon_track.num_buckets);
+    for (list_ele_t* e = game->towers->head; e != NULL; e = e->next) {
+        tower_t* tower = (tower_t*)(e->value);
+        if (tower->next_fire == 0)
+            tower->next_fire = game->tick + 1 + (tower->cooldown > 0 ? rand() % tower->cooldown : 0);
+        if (tower->has_aura) queue_insert_tail(game->aura_towers, tower);
+    }
+    tower_heap_build(&game->tower_schedule, game->towers);
+}
+
 /* ── Path Collision Check ────────────────────────────────────────────── */
 
 bool boxesCollide(position_t p1, int width1, int height1, position_t p2,
@@ -455,6 +755,7 @@ void handlePlayingKeys(game_t* game) {
                 if (!game->SANDBOX) game->coins -= cost;
                 tower_t* tower = initTower(game, type);
                 queue_insert_head(game->towers, (void*)tower);
+                towersChanged(game);
                 game->cursor_type = CURSOR_NONE;
             }
         } else {
@@ -496,6 +797,7 @@ void handlePlayingKeys(game_t* game) {
                 game->cursor.y >= t->position.y - half &&
                 game->cursor.y < t->position.y + half) {
                 t->target_mode = (t->target_mode + 1) % 4;
+                t->target_serial = 0;
                 break;
             }
             curr = curr->next;
@@ -512,18 +814,13 @@ void handlePlayingKeys(game_t* game) {
     /* Graph key: skip round (sandbox only) */
     if ((kb_Data[1] & kb_Graph) && game->SANDBOX) {
         /* Clear all bloons */
-        list_ele_t* curr_box = game->bloons->inited_boxes->head;
-        while (curr_box != NULL) {
-            list_ele_t* next_box = curr_box->next;
-            list_ele_t* curr_elem = ((queue_t*)(curr_box->value))->head;
-            while (curr_elem != NULL) {
-                list_ele_t* next = curr_elem->next;
-                sp_remove(game->bloons, ((bloon_t*)(curr_elem->value))->position,
-                          curr_elem, free);
-                curr_elem = next;
-            }
-            curr_box = next_box;
+        pool_t* pool = &game->bloon_pool;
+        for (size_t i = 0; i < pool->count; i++) {
+            sp_remove(game->bloons, pool_at(pool, i));
         }
+        pool_clear(pool);
+        memset(game->bloon_cells, 0, sizeof(game->bloon_cells));
+        wheel_init(&game->bloon_timers);  /* their timers pointed into the cleared slots */
         game->round_state.complete = true;
         game->key_delay = KEY_DELAY;
     }
@@ -610,7 +907,14 @@ void handleUpgradeScreen(game_t* game) {
                 if (!game->SANDBOX) game->coins -= cost;
                 tower->total_invested += cost;
                 tower->upgrades[path]++;
-                apply_upgrades(tower);
+                uint16_t old_cooldown = tower->cooldown;
+                apply_upgrades(game, tower);
+
+                /* Keep the time since its last shot, as if it had always had
+                 * the new cooldown */
+                int24_t next = (int24_t)tower->next_fire - old_cooldown + tower->cooldown;
+                tower->next_fire = next > (int24_t)game->tick ? (uint24_t)next : game->tick + 1;
+                towersChanged(game);
             }
         }
         game->key_delay = KEY_DELAY;
@@ -619,6 +923,7 @@ void handleUpgradeScreen(game_t* game) {
     /* Mode key: cycle target mode in upgrade screen */
     if (kb_Data[1] & kb_Mode) {
         tower->target_mode = (tower->target_mode + 1) % 4;
+        tower->target_serial = 0;
         game->key_delay = KEY_DELAY;
     }
 
@@ -630,7 +935,9 @@ void handleUpgradeScreen(game_t* game) {
         list_ele_t* curr = game->towers->head;
         while (curr != NULL) {
             if ((tower_t*)(curr->value) == tower) {
+                despawnProjectiles(game, tower);
                 remove_and_delete(game->towers, curr, free);
+                towersChanged(game);
                 break;
             }
             curr = curr->next;
@@ -652,15 +959,16 @@ void handleUpgradeScreen(game_t* game) {
 /* ── Drawing Helpers ──────────────────────────────────────────────────── */
 
 /* Get appropriate bloon sprite based on type + modifiers + state */
-gfx_sprite_t* get_bloon_sprite(bloon_t* bloon) {
+gfx_sprite_t* get_bloon_sprite(game_t* game, bloon_t* bloon) {
+    bool glued = ticks_left(game, bloon->slow_end) > 0;
     if (bloon->type == BLOON_MOAB) {
-        if (bloon->slow_timer > 0) return moab_acid;
+        if (glued) return moab_acid;
         if (bloon->hp <= 50)  return moab_damaged_3;
         if (bloon->hp <= 100) return moab_damaged_2;
         if (bloon->hp <= 150) return moab_damaged_1;
         return moab_undamaged;
     }
-    if (bloon->type == BLOON_RED && bloon->slow_timer > 0) return red_acid;
+    if (bloon->type == BLOON_RED && glued) return red_acid;
 
     /* Select sprite table based on camo/regrow modifiers */
     uint8_t mods = bloon->modifiers & (MOD_CAMO | MOD_REGROW);
@@ -848,83 +1156,72 @@ void drawTowers(game_t* game) {
 }
 
 void drawBloons(game_t* game) {
-    list_ele_t* curr_box = game->bloons->inited_boxes->head;
-    while (curr_box != NULL) {
-        list_ele_t* curr_elem = ((queue_t*)(curr_box->value))->head;
-        while (curr_elem != NULL) {
-            bloon_t* bloon = (bloon_t*)(curr_elem->value);
-            gfx_sprite_t* spr = get_bloon_sprite(bloon);
-
-            /* Center sprite on bloon position */
-            int draw_x = bloon->position.x - (spr->width / 2);
-            int draw_y = bloon->position.y - (spr->height / 2);
-
-            if (bloon->type == BLOON_MOAB) {
-                /* MOABs rotate to face travel direction.
-                 * MOAB sprite native orientation = facing left (128).
-                 * rotation = travel_angle - 128 */
-                uint8_t dir = bloon_direction(bloon, game->path);
-                uint8_t rot = (uint8_t)(dir - 128);  /* MOAB native=left(128), CW rotation */
-                gfx_RotatedScaledTransparentSprite(spr, draw_x, draw_y,
-                                                    rot, 64);
-            } else {
-                gfx_TransparentSprite(spr, draw_x, draw_y);
-            }
-
-            /* Freeze indicator: blue border */
-            if (bloon->freeze_timer > 0) {
-                gfx_SetColor(0x5F);
-                gfx_Rectangle(draw_x - 1, draw_y - 1,
-                              spr->width + 2, spr->height + 2);
-            }
-            /* Stun indicator: yellow border */
-            if (bloon->stun_timer > 0) {
-                gfx_SetColor(148);
-                gfx_Rectangle(draw_x - 1, draw_y - 1,
-                              spr->width + 2, spr->height + 2);
-            }
-            /* Glue indicator: green dot (non-MOAB, non-red which have acid sprite) */
-            if (bloon->slow_timer > 0 && bloon->type != BLOON_RED && bloon->type != BLOON_MOAB) {
-                gfx_SetColor(0x07);
-                gfx_FillCircle(bloon->position.x, bloon->position.y - (spr->height / 2) - 3, 2);
-            }
+    pool_t* pool = &game->bloon_pool;
+    for (size_t i = 0; i < pool->count; i++) {
+        bloon_t* bloon = pool_at(pool, i);
+        if (!sp_linked(&bloon->link)) continue;
+        gfx_sprite_t* spr = get_bloon_sprite(game, bloon);
+
+        /* Center sprite on bloon position */
+        int draw_x = bloon->position.x - (spr->width / 2);
+        int draw_y = bloon->position.y - (spr->height / 2);
+
+        if (bloon->type == BLOON_MOAB) {
+            /* MOABs rotate to face travel direction.
+             * MOAB sprite native orientation = facing left (128).
+             * rotation = travel_angle - 128 */
+            uint8_t dir = bloon_direction(bloon, game->path);
+            uint8_t rot = (uint8_t)(dir - 128);  /* MOAB native=left(128), CW rotation */
+            gfx_RotatedScaledTransparentSprite(spr, draw_x, draw_y,
+                                                rot, 64);
+        } else {
+            gfx_TransparentSprite(spr, draw_x, draw_y);
+        }
 
-            curr_elem = curr_elem->next;
+        /* Freeze indicator: blue border */
+        if (ticks_left(game, bloon->freeze_end) > 0) {
+            gfx_SetColor(0x5F);
+            gfx_Rectangle(draw_x - 1, draw_y - 1,
+                          spr->width + 2, spr->height + 2);
+        }
+        /* Stun indicator: yellow border */
+        if (ticks_left(game, bloon->stun_end) > 0) {
+            gfx_SetColor(148);
+            gfx_Rectangle(draw_x - 1, draw_y - 1,
+                          spr->width + 2, spr->height + 2);
+        }
+        /* Glue indicator: green dot (non-MOAB, non-red which have acid sprite) */
+        if (ticks_left(game, bloon->slow_end) > 0 && bloon->type != BLOON_RED && bloon->type != BLOON_MOAB) {
+            gfx_SetColor(0x07);
+            gfx_FillCircle(bloon->position.x, bloon->position.y - (spr->height / 2) - 3, 2);
         }
-        curr_box = curr_box->next;
     }
 }
 
 void drawProjectiles(game_t* game) {
-    list_ele_t* curr_box = game->projectiles->inited_boxes->head;
-    while (curr_box != NULL) {
-        list_ele_t* curr_elem = ((queue_t*)(curr_box->value))->head;
-        while (curr_elem != NULL) {
-            projectile_t* projectile = (projectile_t*)(curr_elem->value);
-
-            if (projectile->sprite != NULL) {
-                int half = projectile->sprite->width / 2;
-                /* SDK rotation is CW: rot = travel_angle - native */
-                uint8_t native = 192;  /* default: up */
-                if (projectile->owner != NULL) {
-                    native = proj_native_angle[((tower_t*)projectile->owner)->type];
-                }
-                uint8_t rot = (uint8_t)(projectile->angle - native);
-                gfx_RotatedScaledTransparentSprite(
-                    projectile->sprite,
-                    projectile->position.x - half,
-                    projectile->position.y - half,
-                    rot,
-                    64  /* 100% scale */
-                );
-            } else {
-                /* Glue: draw small green circle */
-                gfx_SetColor(0x07);  /* green-ish */
-                gfx_FillCircle(projectile->position.x, projectile->position.y, 3);
-            }
-            curr_elem = curr_elem->next;
+    pool_t* pool = &game->projectile_pool;
+    for (size_t i = 0; i < pool->count; i++) {
+        projectile_t* projectile = pool_at(pool, i);
+        if (!sp_linked(&projectile->link)) continue;
+        gfx_sprite_t* spr = tower_projectile_table[projectile->owner->type];
+
+        if (spr != NULL) {
+            int half = spr->width / 2;
+            /* SDK rotation is CW: rot = travel_angle - native */
+            uint8_t native = proj_native_angle[projectile->owner->type];
+            uint8_t rot = (uint8_t)(projectile->angle - native);
+            gfx_RotatedScaledTransparentSprite(
+                spr,
+                projectile->position.x - half,
+                projectile->position.y - half,
+                rot,
+                64  /* 100% scale */
+            );
+        } else {
+            /* Glue: draw small green circle */
+            gfx_SetColor(0x07);  /* green-ish */
+            gfx_FillCircle(projectile->position.x, projectile->position.y, 3);
         }
-        curr_box = curr_box->next;
     }
 }
 
@@ -1107,50 +1404,23 @@ void drawUpgradeScreen(game_t* game) {
 /* ── Bloon Movement ──────────────────────────────────────────────────── */
 
 int moveBloon(game_t* game, bloon_t* bloon) {
-    int num_segments = game->path->num_points - 1;
     int speed_fp = BLOON_DATA[bloon->type].speed_fp;
 
-    /* Frozen bloons don't move */
-    if (bloon->freeze_timer > 0) {
-        bloon->freeze_timer--;
-        /* Permafrost: apply slow when freeze wears off */
-        if (bloon->freeze_timer == 0 && bloon->frozen_by_permafrost) {
-            bloon->slow_timer = SLOW_DURATION;
-            bloon->frozen_by_permafrost = 0;
-        }
+    /* Frozen bloons don't move (permafrost's slow is started by the thaw
+     * timer) */
+    if (game->tick <= bloon->freeze_end) {
         return bloon->segment;
     }
 
     /* Slowed bloons move at half speed */
-    if (bloon->slow_timer > 0) {
+    if (game->tick <= bloon->slow_end) {
         speed_fp /= SLOW_FACTOR;
-        bloon->slow_timer--;
     }
 
-    int movement = speed_fp;
-
-    while (movement > 0 && bloon->segment < num_segments) {
-        position_t cur = bloon->position;
-        position_t target = game->path->points[bloon->segment + 1];
-        int dx = target.x - cur.x;
-        int dy = target.y - cur.y;
-        int dist_fp = (abs(dx) + abs(dy)) << 8;
-
-        if (movement >= dist_fp) {
-            bloon->position = target;
-            movement -= dist_fp;
-            bloon->segment++;
-        } else {
-            if (abs(dx) >= abs(dy)) {
-                int step = (dx > 0) ? (movement >> 8) : -(movement >> 8);
-                bloon->position.x += step;
-            } else {
-                int step = (dy > 0) ? (movement >> 8) : -(movement >> 8);
-                bloon->position.y += step;
-            }
-            movement = 0;
-        }
-    }
+    /* The fraction stays in dist, so sub-pixel speeds add up exactly */
+    bloon->dist += speed_fp;
+    bloon->segment = path_segment_at(game->path, bloon->dist, bloon->segment);
+    bloon->position = path_point_at(game->path, bloon->segment, bloon->dist);
     return bloon->segment;
 }
 
@@ -1158,29 +1428,29 @@ int moveBloon(game_t* game, bloon_t* bloon) {
 
 /* Helper: spawn a single child bloon */
 static bloon_t* spawn_child(game_t* game, uint8_t type, uint8_t modifiers,
-                             uint8_t regrow_max, uint16_t segment, position_t pos,
+                             uint8_t regrow_max, uint16_t segment, int24_t dist,
+                             position_t pos,
                              int16_t hp_override,
                              uint8_t slow, uint8_t dot_dmg, uint8_t dot_int) {
-    bloon_t* child = safe_malloc(sizeof(bloon_t), __LINE__);
+    bloon_t* child = pool_claim(&game->bloon_pool);
     if (!child) return NULL;
-    memset(child, 0, sizeof(bloon_t));
     child->type = type;
     child->modifiers = modifiers;
     child->hp = hp_override > 0 ? hp_override : BLOON_DATA[type].hp;
     child->regrow_max = regrow_max;
-    child->regrow_timer = REGROW_INTERVAL;
     child->segment = segment;
+    child->dist = dist;
+    child->next_cross = path_next_crossing(game->path, dist);
     child->position = pos;
+    linkBloon(game, child);
     if (slow > 0) {
-        child->slow_timer = slow;
-        child->dot_damage = dot_dmg;
-        child->dot_interval = dot_int;
-        if (dot_dmg > 0) {
-            child->dot_tick = dot_int;
-            child->dot_timer = 180;
-        }
+        child->slow_end = game->tick + slow;
+        if (dot_dmg > 0) start_dot(game, child, dot_dmg, dot_int);
+    }
+    if ((modifiers & MOD_REGROW) && type < regrow_max) {
+        child->regrow_next = game->tick + REGROW_INTERVAL;
+        schedule_bloon(game, child);
     }
-    sp_insert(game->bloons, child->position, child);
     return child;
 }
 
@@ -1192,8 +1462,8 @@ void popBloon(game_t* game, bloon_t* bloon, position_t pos) {
     uint8_t inherit_slow = 0;
     uint8_t inherit_dot_damage = 0;
     uint8_t inherit_dot_interval = 0;
-    if (bloon->slow_timer > 0) {
-        inherit_slow = bloon->slow_timer;
+    if (ticks_left(game, bloon->slow_end) > 0) {
+        inherit_slow = (uint8_t)ticks_left(game, bloon->slow_end);
         inherit_dot_damage = bloon->dot_damage;
         inherit_dot_interval = bloon->dot_interval;
     }
@@ -1206,12 +1476,12 @@ void popBloon(game_t* game, bloon_t* bloon, position_t pos) {
             /* Collapse: 1 child with combined HP */
             int16_t combined_hp = BLOON_DATA[data->child_type].hp * data->child_count;
             spawn_child(game, data->child_type, bloon->modifiers, bloon->regrow_max,
-                        bloon->segment, pos, combined_hp,
+                        bloon->segment, bloon->dist, pos, combined_hp,
                         inherit_slow, inherit_dot_damage, inherit_dot_interval);
         } else {
             for (int i = 0; i < data->child_count; i++) {
                 spawn_child(game, data->child_type, bloon->modifiers, bloon->regrow_max,
-                            bloon->segment, pos, 0,
+                            bloon->segment, bloon->dist, pos, 0,
                             inherit_slow, inherit_dot_damage, inherit_dot_interval);
             }
         }
@@ -1222,12 +1492,12 @@ void popBloon(game_t* game, bloon_t* bloon, position_t pos) {
         if (at_cap && data->child_count2 > 1) {
             int16_t combined_hp = BLOON_DATA[data->child_type2].hp * data->child_count2;
             spawn_child(game, data->child_type2, bloon->modifiers, bloon->regrow_max,
-                        bloon->segment, pos, combined_hp,
+                        bloon->segment, bloon->dist, pos, combined_hp,
                         inherit_slow, inherit_dot_damage, inherit_dot_interval);
         } else {
             for (int i = 0; i < data->child_count2; i++) {
                 spawn_child(game, data->child_type2, bloon->modifiers, bloon->regrow_max,
-                            bloon->segment, pos, 0,
+                            bloon->segment, bloon->dist, pos, 0,
                             inherit_slow, inherit_dot_damage, inherit_dot_interval);
             }
         }
@@ -1253,7 +1523,8 @@ void spawnBloons(game_t* game) {
     if (game->bloons->total_size >= MAX_BLOONS) return;
 
     bloon_t* bloon = initBloon(game, group->bloon_type, group->modifiers);
-    sp_insert(game->bloons, bloon->position, bloon);
+    if (!bloon) return;
+    linkBloon(game, bloon);
     rs->spawned++;
     rs->spacing_timer = group->spacing;
 
@@ -1272,526 +1543,559 @@ bool offScreen(position_t p) {
     return (p.x < -16 || p.y < -16 || p.x > SCREEN_WIDTH + 16 || p.y > SCREEN_HEIGHT + 16);
 }
 
+/* Everything the wheel has due this tick: regrow steps, DoT damage and the
+ * permafrost thaw. Bloons that have none of these never get here. */
+static void runBloonTimers(game_t* game) {
+    timer_link_t* t;
+    while ((t = wheel_expire(&game->bloon_timers, game->tick)) != NULL) {
+        bloon_t* bloon = bloon_of_timer(t);
+
+        /* Regrow mechanic: waits out a stun */
+        if (bloon->regrow_next != 0 && bloon->regrow_next <= game->tick) {
+            if (game->tick <= bloon->stun_end) {
+                bloon->regrow_next = bloon->stun_end + 1;
+            } else {
+                bloon->type++;
+                bloon->hp = BLOON_DATA[bloon->type].hp;
+                game->bloon_cells[bloon->link.box].types |= (uint16_t)(1 << bloon->type);
+                bloon->regrow_next = bloon->type < bloon->regrow_max
+                                         ? game->tick + REGROW_INTERVAL : 0;
+            }
+        }
+
+        /* Damage-over-time (corrosive glue line) */
+        if (bloon->dot_next != 0 && bloon->dot_next <= game->tick) {
+            damage_bloon(game, NULL, bloon, bloon->dot_damage, 0);
+            bloon->dot_left--;
+            bloon->dot_next = bloon->dot_left > 0 ? bloon->dot_next + bloon->dot_interval : 0;
+        }
+
+        /* Permafrost: apply slow when freeze wears off */
+        if (bloon->frozen_by_permafrost && bloon->freeze_end <= game->tick) {
+            bloon->slow_end = game->tick + SLOW_DURATION;
+            bloon->frozen_by_permafrost = 0;
+        }
+
+        schedule_bloon(game, bloon);
+    }
+}
+
 void updateBloons(game_t* game) {
     const int num_segments = game->path->num_points - 1;
 
-    list_ele_t* curr_bloon_box = game->bloons->inited_boxes->head;
-    while (curr_bloon_box != NULL) {
-        list_ele_t* curr_elem = ((queue_t*)(curr_bloon_box->value))->head;
-        list_ele_t* tmp;
-        while (curr_elem != NULL) {
-            bloon_t* curr_bloon = (bloon_t*)(curr_elem->value);
-
-            /* Stun: bloon can't move (like freeze but from bomb/ninja) */
-            if (curr_bloon->stun_timer > 0) {
-                curr_bloon->stun_timer--;
-                /* Still process DoT while stunned */
-                goto do_dot;
+    /* Every bloon is visited here anyway, so the box summaries are rebuilt
+     * from scratch, dropping anything that only over-reports */
+    memset(game->bloon_cells, 0, sizeof(game->bloon_cells));
+
+    pool_t* pool = &game->bloon_pool;
+    for (size_t i = 0; i < pool->count; i++) {
+        bloon_t* curr_bloon = pool_at(pool, i);
+        if (!sp_linked(&curr_bloon->link)) continue;
+
+        /* Stun: bloon can't move (like freeze but from bomb/ninja), though a
+         * knockback may still have left it needing a re-bin */
+        if (game->tick > curr_bloon->stun_end) {
+            int segBeforeMove = curr_bloon->segment;
+            size_t bucketBeforeMove = path_bucket_of(&game->bloon_track, curr_bloon->dist);
+            if (segBeforeMove >= num_segments ||
+                moveBloon(game, curr_bloon) >= num_segments) {
+                event_push(&game->events, EVENT_LEAK,
+                           (int16_t)BLOON_DATA[curr_bloon->type].rbe, curr_bloon, NULL);
+                /* Not counted into bloon_cells yet this tick */
+                wheel_cancel(&game->bloon_timers, &curr_bloon->timer);
+                sp_remove(game->bloons, &curr_bloon->link);
+                continue;
             }
 
-            {
-                position_t pos_before_move = curr_bloon->position;
-                int segBeforeMove = curr_bloon->segment;
-                if (segBeforeMove >= num_segments ||
-                    moveBloon(game, curr_bloon) >= num_segments) {
-                    game->hearts -= BLOON_DATA[curr_bloon->type].rbe;
-                    tmp = curr_elem->next;
-                    sp_remove(game->bloons, pos_before_move, curr_elem, free);
-                    curr_elem = tmp;
+            size_t bucket = path_bucket_of(&game->bloon_track, curr_bloon->dist);
+            if (bucket != bucketBeforeMove) wakeTowers(game, bucket);
+        }
+
+        /* Re-bin only once the bloon has crossed into another box. Iteration
+         * doesn't follow the grid links, so it can happen right away. */
+        if (curr_bloon->dist >= curr_bloon->next_cross) {
+            sp_fix(game->bloons, &curr_bloon->link, curr_bloon->position);
+            curr_bloon->next_cross = path_next_crossing(game->path, curr_bloon->dist);
+        }
+
+        cell_add(game, curr_bloon);
+    }
+
+    runBloonTimers(game);
+}
+
+/* One shot (or freeze, or volley) from a tower whose cooldown is up */
+static void fireTower(game_t* game, tower_t* tower) {
+    const tower_data_t* base = &TOWER_DATA[tower->type];
+
+    if (base->is_area) {
+        /* ── Ice Tower: area freeze ────────────────────────── */
+        int range_sq = (int)tower->range * (int)tower->range;
+        int hit_count = 0;
+
+        const path_index_t* track = &game->bloon_track;
+        uint8_t lanes = tower->can_see_camo ? LANE_CAMO : LANE_PLAIN;
+        TOWER_BUCKETS_FOR_EACH(track, tower, k) {
+            PATH_BUCKET_FOR_EACH(track, k, lanes, bloon) {
+                /* Check immunity to freeze, or already frozen */
+                if ((BLOON_DATA[bloon->type].immunities & IMMUNE_FREEZE) ||
+                    ticks_left(game, bloon->freeze_end) > 0) {
                     continue;
                 }
-            }
 
-            /* Regrow mechanic */
-            if (curr_bloon->modifiers & MOD_REGROW) {
-                if (curr_bloon->type < curr_bloon->regrow_max) {
-                    curr_bloon->regrow_timer--;
-                    if (curr_bloon->regrow_timer == 0) {
-                        curr_bloon->type++;
-                        curr_bloon->hp = BLOON_DATA[curr_bloon->type].hp;
-                        curr_bloon->regrow_timer = REGROW_INTERVAL;
+                int dx = bloon->position.x - tower->position.x;
+                int dy = bloon->position.y - tower->position.y;
+                if (dx * dx + dy * dy <= range_sq && hit_count < tower->pierce) {
+                    bloon->freeze_end = game->tick + FREEZE_DURATION;
+                    if (tower->permafrost) {
+                        bloon->frozen_by_permafrost = 1;
+                        schedule_bloon(game, bloon);
                     }
+                    if (tower->damage > 0) {
+                        damage_bloon(game, tower, bloon, tower->damage, 1);
+                    }
+                    hit_count++;
                 }
             }
-
-do_dot:
-            /* Damage-over-time (corrosive glue line) */
-            if (curr_bloon->dot_timer > 0) {
-                curr_bloon->dot_tick--;
-                if (curr_bloon->dot_tick == 0) {
-                    curr_bloon->hp -= curr_bloon->dot_damage;
-                    curr_bloon->dot_tick = curr_bloon->dot_interval;
+        }
+    } else if (base->is_hitscan) {
+        /* ── Sniper: instant damage ────────────────────────── */
+        bloon_t* target = find_target_bloon(game, tower);
+        if (target) {
+            tower->facing_angle = calculate_angle_int(tower->position, target->position);
+            /* Immune bloons take nothing */
+            int16_t dmg = tower->damage_vs[target->type];
+            if (dmg >= 0) {
+                damage_bloon(game, tower, target, dmg, dmg);
+                if (tower->stun_on_hit > 0) {
+                    target->stun_end = game->tick + tower->stun_on_hit;
                 }
-                curr_bloon->dot_timer--;
             }
-
-            curr_elem = curr_elem->next;
         }
-        curr_bloon_box = curr_bloon_box->next;
-    }
-
-    /* Fix spatial partition boxes after movement */
-    curr_bloon_box = game->bloons->inited_boxes->head;
-    while (curr_bloon_box != NULL) {
-        list_ele_t* curr_elem = ((queue_t*)(curr_bloon_box->value))->head;
-        list_ele_t* next_elem;
-        while (curr_elem != NULL) {
-            next_elem = curr_elem->next;
-            bloon_t* curr_bloon = (bloon_t*)(curr_elem->value);
-            sp_fix_box(game->bloons, (queue_t*)curr_bloon_box->value, curr_elem,
-                       curr_bloon->position);
-            curr_elem = next_elem;
+    } else if (tower->type == TOWER_GLUE) {
+        /* ── Glue: shoot glue projectile ───────────────────── */
+        bloon_t* target = find_target_bloon(game, tower);
+        if (target) {
+            position_t predicted = predict_bloon_position(target, game->path);
+            uint8_t angle = calculate_angle_int(tower->position, predicted);
+            tower->facing_angle = angle;
+            fireProjectile(game, tower, angle);
+        }
+    } else {
+        /* ── Normal projectile towers ──────────────────────── */
+        bloon_t* target = find_target_bloon(game, tower);
+        if (target) {
+            position_t predicted = predict_bloon_position(target, game->path);
+            uint8_t base_angle = calculate_angle_int(tower->position, predicted);
+            tower->facing_angle = base_angle;
+
+            if (tower->projectile_count == 1) {
+                fireProjectile(game, tower, base_angle);
+            } else if (tower->type == TOWER_TACK) {
+                /* Tack: omnidirectional 360° spread */
+                uint8_t step = 256 / tower->projectile_count;
+                for (int i = 0; i < tower->projectile_count; i++) {
+                    uint8_t angle = (uint8_t)(i * step);
+                    fireProjectile(game, tower, angle);
+                }
+            } else {
+                /* Dart/Ninja/etc: tight spread toward target */
+                int spread = 8;  /* ~11° between each projectile */
+                int half = (tower->projectile_count - 1) * spread / 2;
+                for (int i = 0; i < tower->projectile_count; i++) {
+                    uint8_t angle = (uint8_t)(base_angle - half + i * spread);
+                    fireProjectile(game, tower, angle);
+                }
+            }
         }
-        curr_bloon_box = curr_bloon_box->next;
     }
 }
 
 void updateTowers(game_t* game) {
-    list_ele_t* curr_elem = game->towers->head;
-    while (curr_elem != NULL) {
-        tower_t* tower = (tower_t*)(curr_elem->value);
-        tower->tick++;
-
-        /* Arctic Wind aura: slow bloons in range every frame */
-        if (tower->has_aura) {
-            int range_sq = (int)tower->range * (int)tower->range;
-            list_ele_t* bx = game->bloons->inited_boxes->head;
-            while (bx != NULL) {
-                list_ele_t* be = ((queue_t*)(bx->value))->head;
-                while (be != NULL) {
-                    bloon_t* bloon = (bloon_t*)(be->value);
-                    if ((bloon->modifiers & MOD_CAMO) && !tower->can_see_camo) {
-                        be = be->next;
-                        continue;
-                    }
-                    int dx = bloon->position.x - tower->position.x;
-                    int dy = bloon->position.y - tower->position.y;
-                    if (dx * dx + dy * dy <= range_sq) {
-                        if (bloon->slow_timer < SLOW_DURATION)
-                            bloon->slow_timer = SLOW_DURATION;
-                    }
-                    be = be->next;
+    /* Arctic Wind aura: slow bloons in range every frame */
+    for (list_ele_t* e = game->aura_towers->head; e != NULL; e = e->next) {
+        tower_t* tower = (tower_t*)(e->value);
+        int range_sq = (int)tower->range * (int)tower->range;
+        const path_index_t* track = &game->bloon_track;
+        uint8_t lanes = tower->can_see_camo ? LANE_CAMO : LANE_PLAIN;
+        TOWER_BUCKETS_FOR_EACH(track, tower, k) {
+            PATH_BUCKET_FOR_EACH(track, k, lanes, bloon) {
+                int dx = bloon->position.x - tower->position.x;
+                int dy = bloon->position.y - tower->position.y;
+                if (dx * dx + dy * dy <= range_sq) {
+                    if (ticks_left(game, bloon->slow_end) < SLOW_DURATION)
+                        bloon->slow_end = game->tick + SLOW_DURATION;
                 }
-                bx = bx->next;
             }
         }
+    }
 
-        if (tower->tick >= tower->cooldown) {
-            tower->tick = 0;
-            const tower_data_t* base = &TOWER_DATA[tower->type];
-
-            if (base->is_area) {
-                /* ── Ice Tower: area freeze ────────────────────────── */
-                int range_sq = (int)tower->range * (int)tower->range;
-                int hit_count = 0;
-
-                list_ele_t* bx = game->bloons->inited_boxes->head;
-                while (bx != NULL) {
-                    list_ele_t* be = ((queue_t*)(bx->value))->head;
-                    while (be != NULL) {
-                        bloon_t* bloon = (bloon_t*)(be->value);
-
-                        /* Skip camo if can't see */
-                        if ((bloon->modifiers & MOD_CAMO) && !tower->can_see_camo) {
-                            be = be->next;
-                            continue;
-                        }
-
-                        /* Check immunity to freeze, or already frozen */
-                        if ((BLOON_DATA[bloon->type].immunities & IMMUNE_FREEZE) ||
-                            bloon->freeze_timer > 0) {
-                            be = be->next;
-                            continue;
-                        }
-
-                        int dx = bloon->position.x - tower->position.x;
-                        int dy = bloon->position.y - tower->position.y;
-                        if (dx * dx + dy * dy <= range_sq && hit_count < tower->pierce) {
-                            bloon->freeze_timer = FREEZE_DURATION;
-                            if (tower->permafrost) bloon->frozen_by_permafrost = 1;
-                            if (tower->damage > 0) {
-                                bloon->hp -= tower->damage;
-                                tower->pop_count++;
-                            }
-                            hit_count++;
-                        }
-                        be = be->next;
-                    }
-                    bx = bx->next;
-                }
-            } else if (base->is_hitscan) {
-                /* ── Sniper: instant damage ────────────────────────── */
-                bloon_t* target = find_target_bloon(game, tower);
-                if (target) {
-                    tower->facing_angle = calculate_angle_int(tower->position, target->position);
-                    /* Check immunity */
-                    if (!(BLOON_DATA[target->type].immunities & tower->damage_type) ||
-                        tower->damage_type == DMG_NORMAL) {
-                        uint8_t dmg = tower->damage;
-                        if (target->type == BLOON_MOAB && tower->moab_damage_mult > 1) {
-                            dmg = dmg * tower->moab_damage_mult;
-                        }
-                        target->hp -= dmg;
-                        tower->pop_count += dmg;
-                        if (tower->stun_on_hit > 0) {
-                            target->stun_timer = tower->stun_on_hit;
-                        }
-                    }
-                }
-            } else if (tower->type == TOWER_GLUE) {
-                /* ── Glue: shoot glue projectile ───────────────────── */
-                bloon_t* target = find_target_bloon(game, tower);
-                if (target) {
-                    position_t predicted = predict_bloon_position(target, game->path);
-                    uint8_t angle = calculate_angle_int(tower->position, predicted);
-                    tower->facing_angle = angle;
-                    projectile_t* proj = initProjectile(game, tower, angle);
-                    sp_insert(game->projectiles, proj->position, proj);
-                }
-            } else {
-                /* ── Normal projectile towers ──────────────────────── */
-                bloon_t* target = find_target_bloon(game, tower);
-                if (target) {
-                    position_t predicted = predict_bloon_position(target, game->path);
-                    uint8_t base_angle = calculate_angle_int(tower->position, predicted);
-                    tower->facing_angle = base_angle;
-
-                    if (tower->projectile_count == 1) {
-                        projectile_t* proj = initProjectile(game, tower, base_angle);
-                        sp_insert(game->projectiles, proj->position, proj);
-                    } else if (tower->type == TOWER_TACK) {
-                        /* Tack: omnidirectional 360° spread */
-                        uint8_t step = 256 / tower->projectile_count;
-                        for (int i = 0; i < tower->projectile_count; i++) {
-                            uint8_t angle = (uint8_t)(i * step);
-                            projectile_t* proj = initProjectile(game, tower, angle);
-                            sp_insert(game->projectiles, proj->position, proj);
-                        }
-                    } else {
-                        /* Dart/Ninja/etc: tight spread toward target */
-                        int spread = 8;  /* ~11° between each projectile */
-                        int half = (tower->projectile_count - 1) * spread / 2;
-                        for (int i = 0; i < tower->projectile_count; i++) {
-                            uint8_t angle = (uint8_t)(base_angle - half + i * spread);
-                            projectile_t* proj = initProjectile(game, tower, angle);
-                            sp_insert(game->projectiles, proj->position, proj);
-                        }
-                    }
-                }
-            }
+    /* Only the towers whose cooldown is up; a tower without a target still
+     * waits out a full cooldown before looking again. At most
+     * TOWER_FIRE_BUDGET of them search for targets per tick; the rest stay
+     * due, and being the most overdue they come off the heap first next tick. */
+    tower_heap_t* schedule = &game->tower_schedule;
+    tower_t* tower;
+    uint8_t budget = TOWER_FIRE_BUDGET;
+    while ((tower = tower_heap_top(schedule)) != NULL &&
+           tower->next_fire <= game->tick) {
+        uint16_t cooldown = tower->cooldown > 0 ? tower->cooldown : 1;
+
+        /* Nothing in range: sleep rather than look again every cooldown */
+        if (tower_range_empty(&game->bloon_track, tower)) {
+            tower->next_fire = game->tick + cooldown;
+            tower_heap_pop(schedule);
+            sleepTower(game, tower);
+            continue;
         }
-        curr_elem = curr_elem->next;
+
+        if (budget == 0) break;
+
+        /* No room for the whole volley: try again next tick rather than
+         * spend the cooldown on shots that would be dropped */
+        const tower_data_t* base = &TOWER_DATA[tower->type];
+        if (!base->is_area && !base->is_hitscan &&
+            game->projectile_pool.count + tower->projectile_count > MAX_PROJECTILES) {
+            tower->next_fire = game->tick + 1;
+            tower_heap_sift_top(schedule);
+            continue;
+        }
+        budget--;
+
+        /* Count the cooldown from when the shot was due, so one that waited
+         * for the budget doesn't push back the ones after it */
+        tower->next_fire += cooldown;
+        if (tower->next_fire <= game->tick) tower->next_fire = game->tick + 1;
+        tower_heap_sift_top(schedule);
+        fireTower(game, tower);
     }
 }
 
 void updateProjectiles(game_t* game) {
-    list_ele_t* curr_box = game->projectiles->inited_boxes->head;
-    while (curr_box != NULL) {
-        list_ele_t* curr_elem = ((queue_t*)(curr_box->value))->head;
-        list_ele_t* tmp;
-        while (curr_elem != NULL) {
-            projectile_t* proj = (projectile_t*)(curr_elem->value);
-            tmp = curr_elem->next;
-
-            /* Despawn if off-screen or lifetime expired */
-            if (offScreen(proj->position) || proj->lifetime == 0) {
-                sp_remove(game->projectiles, proj->position, curr_elem, free);
-                curr_elem = tmp;
-                continue;
-            }
-            proj->lifetime--;
-
-            /* Homing: adjust angle toward nearest bloon (3x3 cell search) */
-            if (proj->is_homing) {
-                int best_dist = 60 * 60;
-                bloon_t* seek_target = NULL;
-                multi_list_t* ml = game->bloons;
-                int bs = (int)ml->box_size;
-                int cx = proj->position.x / bs;
-                int cy = proj->position.y / bs;
-                for (int ddy = -1; ddy <= 1; ddy++) {
-                    int ry = cy + ddy;
-                    if (ry < 0 || ry >= (int)ml->height) continue;
-                    for (int ddx = -1; ddx <= 1; ddx++) {
-                        int rx = cx + ddx;
-                        if (rx < 0 || rx >= (int)ml->width) continue;
-                        queue_t* box = ml->boxes[ry * (int)ml->width + rx];
-                        if (box == NULL) continue;
-                        list_ele_t* be = box->head;
-                        while (be != NULL) {
-                            bloon_t* b = (bloon_t*)(be->value);
-                            /* Skip camo if can't see */
-                            if ((b->modifiers & MOD_CAMO) && !proj->can_see_camo) {
-                                be = be->next; continue;
-                            }
-                            /* Skip immune bloons */
-                            if (proj->damage_type != DMG_NORMAL &&
-                                (BLOON_DATA[b->type].immunities & proj->damage_type)) {
-                                be = be->next; continue;
-                            }
-                            int dx = b->position.x - proj->position.x;
-                            int dy = b->position.y - proj->position.y;
-                            int d2 = dx * dx + dy * dy;
-                            if (d2 < best_dist) {
-                                best_dist = d2;
-                                seek_target = b;
-                            }
-                            be = be->next;
-                        }
+    pool_t* pool = &game->projectile_pool;
+    for (size_t i = 0; i < pool->count; i++) {
+        projectile_t* proj = pool_at(pool, i);
+        if (!sp_linked(&proj->link)) continue;
+        tower_t* owner = proj->owner;
+
+        /* Despawn if off-screen or lifetime expired */
+        if (offScreen(proj->position) || proj->lifetime == 0) {
+            sp_remove(game->projectiles, &proj->link);
+            continue;
+        }
+        proj->lifetime--;
+
+        /* Homing: adjust angle toward nearest bloon within 60px */
+        if (owner->is_homing) {
+            int best_dist = 60 * 60;
+            bloon_t* seek_target = NULL;
+            multi_list_t* ml = game->bloons;
+            uint8_t boxes[SP_MASK_BYTES];
+            sp_query_circle(ml, proj->position, 60, boxes);
+            SP_MASK_FOR_EACH(boxes, ml->n, box) {
+                const bloon_cell_t* cell = &game->bloon_cells[box];
+                if (!owner->can_see_camo && cell->plain == 0) continue;
+                if (!(cell->types & owner->hit_types)) continue;
+
+                SP_BOX_FOR_EACH_UPTO(ml, box, owner->can_see_camo ? LANE_CAMO : LANE_PLAIN, be) {
+                    bloon_t* b = (bloon_t*)be;
+                    /* Skip immune bloons */
+                    if (owner->damage_vs[b->type] < 0) continue;
+                    int dx = b->position.x - proj->position.x;
+                    int dy = b->position.y - proj->position.y;
+                    int d2 = dx * dx + dy * dy;
+                    if (d2 < best_dist) {
+                        best_dist = d2;
+                        seek_target = b;
                     }
                 }
-                if (seek_target) {
-                    uint8_t desired = iatan2(seek_target->position.y - proj->position.y,
-                                             seek_target->position.x - proj->position.x);
-                    proj->angle = desired;  /* snap to target — no wiggle */
-                }
             }
+            if (seek_target) {
+                uint8_t desired = iatan2(seek_target->position.y - proj->position.y,
+                                         seek_target->position.x - proj->position.x);
+                proj->angle = desired;  /* snap to target — no wiggle */
+            }
+        }
 
-            /* Integer movement using LUT */
-            proj->position.x += (int16_t)((cos_lut[proj->angle] * (int16_t)proj->speed) >> 8);
-            proj->position.y += (int16_t)((sin_lut[proj->angle] * (int16_t)proj->speed) >> 8);
+        /* Integer movement using LUT */
+        proj->from = proj->position;
+        proj->position.x += (int16_t)((cos_lut[proj->angle] * (int16_t)owner->projectile_speed) >> 8);
+        proj->position.y += (int16_t)((sin_lut[proj->angle] * (int16_t)owner->projectile_speed) >> 8);
 
-            curr_elem = tmp;
-        }
-        curr_box = curr_box->next;
-    }
-
-    /* Fix spatial partition boxes */
-    curr_box = game->projectiles->inited_boxes->head;
-    while (curr_box != NULL) {
-        list_ele_t* curr_elem = ((queue_t*)(curr_box->value))->head;
-        list_ele_t* next_elem;
-        while (curr_elem != NULL) {
-            next_elem = curr_elem->next;
-            projectile_t* proj = (projectile_t*)(curr_elem->value);
-            sp_fix_box(game->projectiles, (queue_t*)curr_box->value, curr_elem,
-                       proj->position);
-            curr_elem = next_elem;
-        }
-        curr_box = curr_box->next;
+        /* Iteration doesn't follow the grid links, so re-bin right away */
+        sp_fix(game->projectiles, &proj->link, proj->position);
     }
 }
 
-/* Splash damage helper: only checks 3x3 neighborhood of spatial cells.
- * Does NOT pop bloons — just applies damage. checkHitscanPops handles pops
- * afterward, avoiding cascading child spawns during iteration. */
+/* Splash damage helper: only checks the grid boxes the blast circle reaches.
+ * Does NOT pop bloons — just applies damage. Pops are queued and happen in
+ * applyEvents, avoiding cascading child spawns during iteration. */
 void applySplashDamage(game_t* game, projectile_t* proj, bloon_t* direct_hit) {
-    int sr = (int)proj->splash_radius;
+    tower_t* owner = proj->owner;
+    int sr = (int)owner->splash_radius;
     int sr_sq = sr * sr;
     int splash_hits = 0;
     int max_hits = proj->pierce > 6 ? 6 : proj->pierce;  /* cap splash targets */
     multi_list_t* ml = game->bloons;
-    int bs = (int)ml->box_size;
-
-    /* Compute center cell */
-    int cx = proj->position.x / bs;
-    int cy = proj->position.y / bs;
-
-    /* Check 3x3 neighborhood */
-    for (int dy = -1; dy <= 1 && splash_hits < max_hits; dy++) {
-        int ry = cy + dy;
-        if (ry < 0 || ry >= (int)ml->height) continue;
-        for (int dx = -1; dx <= 1 && splash_hits < max_hits; dx++) {
-            int rx = cx + dx;
-            if (rx < 0 || rx >= (int)ml->width) continue;
-            queue_t* box = ml->boxes[ry * (int)ml->width + rx];
-            if (box == NULL) continue;
-            list_ele_t* sbe = box->head;
-            while (sbe != NULL && splash_hits < max_hits) {
-                bloon_t* sb = (bloon_t*)(sbe->value);
-                if (sb != direct_hit) {
-                    int sdx = sb->position.x - proj->position.x;
-                    int sdy = sb->position.y - proj->position.y;
-                    if (sdx * sdx + sdy * sdy <= sr_sq) {
-                        if (proj->damage_type != DMG_NORMAL &&
-                            (BLOON_DATA[sb->type].immunities & proj->damage_type)) {
-                            sbe = sbe->next;
-                            continue;
-                        }
-                        uint8_t splash_dmg = proj->damage;
-                        if (proj->owner && sb->type == BLOON_MOAB) {
-                            uint8_t mult = ((tower_t*)proj->owner)->moab_damage_mult;
-                            if (mult > 1) splash_dmg = splash_dmg * mult;
-                        }
-                        sb->hp -= splash_dmg;
-                        if (proj->stun_duration > 0)
-                            sb->stun_timer = proj->stun_duration;
-                        if (proj->owner)
-                            ((tower_t*)proj->owner)->pop_count += splash_dmg;
-                        splash_hits++;
-                    }
+
+    /* Only the boxes the blast radius reaches */
+    uint8_t boxes[SP_MASK_BYTES];
+    sp_query_circle(ml, proj->position, sr, boxes);
+    SP_MASK_FOR_EACH(boxes, ml->n, b) {
+        if (splash_hits >= max_hits) break;
+        /* Every bloon in this box shrugs off the blast */
+        if (!(game->bloon_cells[b].types & owner->hit_types)) continue;
+
+        SP_BOX_FOR_EACH(ml, b, sbe) {
+            if (splash_hits >= max_hits) break;
+            bloon_t* sb = (bloon_t*)sbe;
+            if (sb != direct_hit && sb->hp > 0) {
+                int sdx = sb->position.x - proj->position.x;
+                int sdy = sb->position.y - proj->position.y;
+                if (sdx * sdx + sdy * sdy <= sr_sq) {
+                    int16_t splash_dmg = owner->damage_vs[sb->type];
+                    if (splash_dmg < 0) continue;
+                    damage_bloon(game, owner, sb, splash_dmg, splash_dmg);
+                    if (owner->stun_on_hit > 0)
+                        sb->stun_end = game->tick + owner->stun_on_hit;
+                    splash_hits++;
                 }
-                sbe = sbe->next;
             }
         }
     }
 }
 
-void checkBloonProjCollissions(game_t* game) {
-    list_ele_t* next_bloon_elem = NULL;
-    list_ele_t* next_proj_elem = NULL;
-
-    list_ele_t* curr_bloon_box = game->bloons->inited_boxes->head;
-    while (curr_bloon_box != NULL) {
-        list_ele_t* curr_bloon_elem = ((queue_t*)(curr_bloon_box->value))->head;
-        if (curr_bloon_elem == NULL) {
-            curr_bloon_box = curr_bloon_box->next;
-            continue;
-        }
+/* Bloons one projectile can line up in a single tick; past this only the
+ * earliest are kept */
+#define SWEEP_MAX_HITS 16
 
-        queue_t* same_box_projs = sp_soft_get_list(
-            game->projectiles, ((bloon_t*)(curr_bloon_elem->value))->position);
-        if (same_box_projs == NULL) {
-            curr_bloon_box = curr_bloon_box->next;
-            continue;
-        }
+typedef struct {
+    bloon_t* bloon;
+    uint8_t toi;            // time of impact in 1/256ths of the tick's move
+} sweep_hit_t;
 
-        while (curr_bloon_elem != NULL) {
-            next_bloon_elem = curr_bloon_elem->next;
+/* Narrow one axis of a sweep to where `a + d * t` lies strictly inside
+ * (lo, hi). Times are fractions num/den with den > 0. Returns false if the
+ * axis never overlaps. */
+static bool sweep_axis(int a, int d, int lo, int hi, int* enter_num,
+                       int* enter_den, int* exit_num, int* exit_den) {
+    if (d == 0) return lo < a && a < hi;
 
-            bloon_t* tmp_bloon = (bloon_t*)(curr_bloon_elem->value);
-            gfx_sprite_t* bspr = bloon_sprite_table[tmp_bloon->type];
+    int den = d > 0 ? d : -d;
+    int in_num = d > 0 ? lo - a : a - hi;
+    int out_num = d > 0 ? hi - a : a - lo;
+
+    if (in_num * *enter_den > *enter_num * den) {
+        *enter_num = in_num;
+        *enter_den = den;
+    }
+    if (out_num * *exit_den < *exit_num * den) {
+        *exit_num = out_num;
+        *exit_den = den;
+    }
+    return true;
+}
+
+/* When a projectile of size pw x ph moving its center from `a` to `b` first
+ * overlaps a bloon box of size bw x bh at `tl`, in 1/256ths of the move; -1
+ * if it doesn't this tick. At t = 1 this is exactly boxesCollide. */
+static int sweep_enter(position_t a, position_t b, int pw, int ph,
+                       position_t tl, int bw, int bh) {
+    // the center must be strictly inside the bloon box grown by the projectile
+    int enter_num = 0, enter_den = 1;
+    int exit_num = 1, exit_den = 1;
+
+    if (!sweep_axis(a.x, b.x - a.x, tl.x - (pw - pw / 2), tl.x + bw + pw / 2,
+                    &enter_num, &enter_den, &exit_num, &exit_den)) return -1;
+    if (!sweep_axis(a.y, b.y - a.y, tl.y - (ph - ph / 2), tl.y + bh + ph / 2,
+                    &enter_num, &enter_den, &exit_num, &exit_den)) return -1;
+    if (enter_num * exit_den >= exit_num * enter_den) return -1;
+
+    return (enter_num * 256) / enter_den;
+}
+
+/* Every bloon the projectile sweeps through this tick, earliest first; equal
+ * times keep grid order, so the result is deterministic */
+static uint8_t sweep_projectile(game_t* game, projectile_t* proj,
+                                sweep_hit_t hits[SWEEP_MAX_HITS]) {
+    multi_list_t* ml = game->bloons;
+    gfx_sprite_t* pspr = tower_projectile_table[proj->owner->type];
+    int pw = pspr ? pspr->width : 6;
+    int ph = pspr ? pspr->height : 6;
+    position_t a = proj->from;
+    position_t b = proj->position;
+    uint8_t num_hits = 0;
+
+    /* Every box holding a bloon center that could reach the swept projectile
+     * box this tick */
+    uint8_t boxes[SP_MASK_BYTES];
+    sp_query_rect(ml, (a.x < b.x ? a.x : b.x) - pw / 2 - bloon_reach,
+                  (a.y < b.y ? a.y : b.y) - ph / 2 - bloon_reach,
+                  (a.x > b.x ? a.x : b.x) - pw / 2 + pw - 1 + bloon_reach,
+                  (a.y > b.y ? a.y : b.y) - ph / 2 + ph - 1 + bloon_reach, boxes);
+
+    SP_MASK_FOR_EACH(boxes, ml->n, box) {
+        /* Nothing here the shot can hurt, and no splash to set off */
+        if (proj->owner->splash_radius == 0 &&
+            !(game->bloon_cells[box].types & proj->owner->hit_types)) continue;
+
+        SP_BOX_FOR_EACH(ml, box, be) {
+            bloon_t* bloon = (bloon_t*)be;
+            gfx_sprite_t* bspr = bloon_sprite_table[bloon->type];
             int bw = bspr->width;
             int bh = bspr->height;
             /* Centered bounding box (matches visual centering) */
-            position_t bloon_tl = { tmp_bloon->position.x - bw / 2,
-                                    tmp_bloon->position.y - bh / 2 };
-
-            list_ele_t* curr_proj_elem = same_box_projs->head;
-            while (curr_proj_elem != NULL) {
-                next_proj_elem = curr_proj_elem->next;
-
-                projectile_t* tmp_proj = (projectile_t*)curr_proj_elem->value;
-
-                int pw = tmp_proj->sprite ? tmp_proj->sprite->width : 6;
-                int ph = tmp_proj->sprite ? tmp_proj->sprite->height : 6;
-                position_t proj_tl = { tmp_proj->position.x - pw / 2,
-                                       tmp_proj->position.y - ph / 2 };
-
-                if (boxesCollide(bloon_tl, bw, bh, proj_tl, pw, ph)) {
-
-                    /* Check immunity: if projectile's damage type is blocked
-                     * by bloon's immunities, skip direct damage but still splash */
-                    if (tmp_proj->damage_type != DMG_NORMAL &&
-                        (BLOON_DATA[tmp_bloon->type].immunities & tmp_proj->damage_type)) {
-                        /* Splash still detonates on immune targets */
-                        if (tmp_proj->splash_radius > 0) {
-                            applySplashDamage(game, tmp_proj, tmp_bloon);
-                            tmp_proj->pierce--;
-                            if (tmp_proj->pierce <= 0) {
-                                sp_remove(game->projectiles, tmp_proj->position,
-                                          curr_proj_elem, free);
-                            }
-                            break;
-                        }
-                        curr_proj_elem = next_proj_elem;
-                        continue;
-                    }
-
-                    /* Glue projectile: pass through already-slowed bloons */
-                    if (tmp_proj->damage_type == DMG_NORMAL && tmp_proj->damage == 0 &&
-                        tmp_proj->dot_damage == 0 && tmp_bloon->slow_timer > 0) {
-                        curr_proj_elem = next_proj_elem;
-                        continue;
-                    }
+            position_t bloon_tl = { bloon->position.x - bw / 2,
+                                    bloon->position.y - bh / 2 };
 
-                    /* Glue projectile: apply slow to un-slowed bloons */
-                    if (tmp_proj->damage_type == DMG_NORMAL && tmp_proj->damage == 0) {
-                        uint8_t slow_dur = SLOW_DURATION;
-                        if (tmp_proj->owner) {
-                            slow_dur = ((tower_t*)tmp_proj->owner)->slow_duration;
-                        }
-                        tmp_bloon->slow_timer = slow_dur;
-                    }
+            int toi = sweep_enter(a, b, pw, ph, bloon_tl, bw, bh);
+            if (toi < 0) continue;
 
-                    /* Apply DoT from projectile (corrosive glue) */
-                    if (tmp_proj->dot_damage > 0) {
-                        tmp_bloon->dot_damage = tmp_proj->dot_damage;
-                        tmp_bloon->dot_interval = tmp_proj->dot_interval;
-                        tmp_bloon->dot_tick = tmp_proj->dot_interval;
-                        tmp_bloon->dot_timer = 180;  /* ~3 seconds of DoT */
-                    }
-
-                    /* Apply stun */
-                    if (tmp_proj->stun_duration > 0) {
-                        tmp_bloon->stun_timer = tmp_proj->stun_duration;
-                    }
+            /* insertion sort, dropping the latest once full */
+            uint8_t j = num_hits < SWEEP_MAX_HITS ? num_hits++ : SWEEP_MAX_HITS;
+            while (j > 0 && hits[j - 1].toi > toi) {
+                if (j < SWEEP_MAX_HITS) hits[j] = hits[j - 1];
+                j--;
+            }
+            if (j < SWEEP_MAX_HITS) {
+                hits[j].bloon = bloon;
+                hits[j].toi = (uint8_t)toi;
+            }
+        }
+    }
+    return num_hits;
+}
 
-                    /* Compute effective damage with MOAB multiplier */
-                    uint8_t eff_damage = tmp_proj->damage;
-                    if (tmp_proj->owner && tmp_bloon->type == BLOON_MOAB) {
-                        uint8_t mult = ((tower_t*)tmp_proj->owner)->moab_damage_mult;
-                        if (mult > 1) eff_damage = eff_damage * mult;
-                    }
+/* Each projectile sweeps from where it started the tick to where it is now,
+ * so fast shots can't tunnel through bloons, and spends its pierce on what it
+ * passes through in order of impact */
+void checkBloonProjCollissions(game_t* game) {
+    multi_list_t* bloons = game->bloons;
+    pool_t* pool = &game->projectile_pool;
+    sweep_hit_t hits[SWEEP_MAX_HITS];
+
+    for (size_t i = 0; i < pool->count; i++) {
+        projectile_t* tmp_proj = pool_at(pool, i);
+        if (!sp_linked(&tmp_proj->link)) continue;
+        tower_t* owner = tmp_proj->owner;
+
+        uint8_t num_hits = sweep_projectile(game, tmp_proj, hits);
+        for (uint8_t h = 0; h < num_hits && tmp_proj->pierce > 0; h++) {
+            bloon_t* tmp_bloon = hits[h].bloon;
+            /* already out of hp; its pop is queued */
+            if (tmp_bloon->hp <= 0) continue;
+
+            /* Check immunity: if projectile's damage type is blocked
+             * by bloon's immunities, skip direct damage but still splash */
+            int16_t eff_damage = owner->damage_vs[tmp_bloon->type];
+            if (eff_damage < 0) {
+                /* Splash still detonates on immune targets */
+                if (owner->splash_radius > 0) {
+                    applySplashDamage(game, tmp_proj, tmp_bloon);
+                    tmp_proj->pierce--;
+                }
+                continue;
+            }
 
-                    /* Apply damage + track pops on owner tower */
-                    tmp_bloon->hp -= eff_damage;
-                    if (tmp_proj->owner != NULL) {
-                        ((tower_t*)tmp_proj->owner)->pop_count += eff_damage;
-                    }
+            /* Glue projectile: pass through already-slowed bloons */
+            if (owner->damage_type == DMG_NORMAL && owner->damage == 0 &&
+                owner->dot_damage == 0 && ticks_left(game, tmp_bloon->slow_end) > 0) {
+                continue;
+            }
 
-                    /* Counter-Espionage: strip camo on hit */
-                    if (tmp_proj->strips_camo) {
-                        tmp_bloon->modifiers &= ~MOD_CAMO;
-                    }
+            /* Glue projectile: apply slow to un-slowed bloons */
+            if (owner->damage_type == DMG_NORMAL && owner->damage == 0) {
+                tmp_bloon->slow_end = game->tick + owner->slow_duration;
+            }
 
-                    /* Distraction: 25% chance to knock bloon back 1 segment */
-                    if (tmp_proj->owner && ((tower_t*)tmp_proj->owner)->distraction) {
-                        if ((rand() & 3) == 0 && tmp_bloon->segment > 0) {
-                            tmp_bloon->segment--;
-                        }
-                    }
+            /* Apply DoT from projectile (corrosive glue) */
+            if (owner->dot_damage > 0) {
+                start_dot(game, tmp_bloon, owner->dot_damage, owner->dot_interval);
+            }
 
-                    if (tmp_bloon->hp <= 0) {
-                        popBloon(game, tmp_bloon, tmp_bloon->position);
-                        sp_remove(game->bloons, tmp_bloon->position,
-                                  curr_bloon_elem, free);
-                    }
+            /* Apply stun */
+            if (owner->stun_on_hit > 0) {
+                tmp_bloon->stun_end = game->tick + owner->stun_on_hit;
+            }
 
-                    /* Splash damage: damage nearby bloons (3x3 cell neighborhood) */
-                    if (tmp_proj->splash_radius > 0) {
-                        applySplashDamage(game, tmp_proj, tmp_bloon);
-                    }
+            /* Apply damage + track pops on owner tower */
+            damage_bloon(game, owner, tmp_bloon, eff_damage, eff_damage);
 
-                    /* Reduce projectile pierce */
-                    tmp_proj->pierce--;
-                    if (tmp_proj->pierce <= 0) {
-                        sp_remove(game->projectiles, tmp_proj->position,
-                                  curr_proj_elem, free);
-                    }
+            /* Counter-Espionage: strip camo on hit */
+            if (owner->strips_camo && (tmp_bloon->modifiers & MOD_CAMO)) {
+                tmp_bloon->modifiers &= ~MOD_CAMO;
+                sp_set_lane(bloons, &tmp_bloon->link, LANE_PLAIN);
+                game->bloon_cells[tmp_bloon->link.box].camo--;
+                game->bloon_cells[tmp_bloon->link.box].plain++;
+            }
 
-                    break;  // move to next bloon
+            /* Distraction: 25% chance to knock bloon back to the start
+             * of its segment */
+            if (owner->distraction) {
+                if ((rand() & 3) == 0 && tmp_bloon->segment < game->path->num_points - 1) {
+                    tmp_bloon->dist = game->path->cum_length[tmp_bloon->segment];
+                    tmp_bloon->position = game->path->points[tmp_bloon->segment];
+                    tmp_bloon->next_cross = tmp_bloon->dist;  /* re-bin next update */
+                    wakeTowers(game, path_bucket_of(&game->bloon_track, tmp_bloon->dist));
                 }
-                curr_proj_elem = next_proj_elem;
             }
 
-            curr_bloon_elem = next_bloon_elem;
+            /* Splash damage: damage bloons inside the blast radius */
+            if (owner->splash_radius > 0) {
+                applySplashDamage(game, tmp_proj, tmp_bloon);
+            }
+
+            /* Reduce projectile pierce */
+            tmp_proj->pierce--;
         }
 
-        curr_bloon_box = curr_bloon_box->next;
+        if (tmp_proj->pierce <= 0) {
+            sp_remove(game->projectiles, &tmp_proj->link);
+        }
     }
 }
 
-/* Check for bloons with hp <= 0 from hitscan/ice damage */
-void checkHitscanPops(game_t* game) {
-    list_ele_t* curr_box = game->bloons->inited_boxes->head;
-    while (curr_box != NULL) {
-        list_ele_t* curr_elem = ((queue_t*)(curr_box->value))->head;
-        while (curr_elem != NULL) {
-            list_ele_t* next = curr_elem->next;
-            bloon_t* bloon = (bloon_t*)(curr_elem->value);
-            if (bloon->hp <= 0) {
-                popBloon(game, bloon, bloon->position);
-                sp_remove(game->bloons, bloon->position, curr_elem, free);
-            }
-            curr_elem = next;
+/* Act on everything recorded this tick, in the order it happened */
+void applyEvents(game_t* game) {
+    event_queue_t* q = &game->events;
+    for (size_t i = 0; i < q->count; i++) {
+        game_event_t* ev = &q->items[i];
+        switch (ev->kind) {
+            case EVENT_POP:
+                if (!sp_linked(&ev->bloon->link)) break;
+                popBloon(game, ev->bloon, ev->bloon->position);
+                unlinkBloon(game, ev->bloon);
+                break;
+            case EVENT_LEAK:
+                game->hearts -= ev->amount;
+                break;
         }
-        curr_box = curr_box->next;
     }
+    event_queue_clear(q);
 }
 
 /* ── Game Logic ──────────────────────────────────────────────────────── */
 
+/* One tick of the simulation, without input or drawing */
+void stepGame(game_t* game) {
+    game->tick++;
+    spawnBloons(game);
+    updateBloons(game);
+    sp_rebuild(game->bloons, &game->bloon_pool);
+    path_index_rebuild(&game->bloon_track, &game->bloon_pool);
+    updateProjectiles(game);
+    updateTowers(game);
+    sp_rebuild(game->projectiles, &game->projectile_pool);
+    checkBloonProjCollissions(game);
+    applyEvents(game);
+
+    /* Dead bloons and projectiles only give up their slots here, so pointers
+     * taken anywhere above (including the events) stay valid for the whole
+     * tick */
+    sp_compact(game->bloons, &game->bloon_pool);
+    sp_compact(game->projectiles, &game->projectile_pool);
+}
+
 void handleGame(game_t* game) {
     handlePlayingKeys(game);
 
@@ -1831,12 +2135,7 @@ void handleGame(game_t* game) {
         return;
     }
 
-    spawnBloons(game);
-    updateProjectiles(game);
-    updateBloons(game);
-    updateTowers(game);
-    checkBloonProjCollissions(game);
-    checkHitscanPops(game);
+    stepGame(game);
 }
 
 /* ── Game Creation ───────────────────────────────────────────────────── */
@@ -1846,12 +2145,30 @@ game_t* newGame(position_t* points, size_t num_points) {
     memset(game, 0, sizeof(game_t));
 
     game->path = newPath(points, num_points, DEFAULT_PATH_WIDTH);
+    bloon_reach = 0;
+    for (uint8_t t = 0; t < NUM_BLOON_TYPES; t++) {
+        gfx_sprite_t* spr = bloon_sprite_table[t];
+        if (spr->width - spr->width / 2 > bloon_reach) bloon_reach = spr->width - spr->width / 2;
+        if (spr->height - spr->height / 2 > bloon_reach) bloon_reach = spr->height - spr->height / 2;
+    }
+    path_index_init(&game->bloon_track, game->path, BLOON_POOL_SIZE);
     game->hearts = 100;
     game->coins = 650;
 
     game->towers = queue_new();
-    game->bloons = new_partitioned_list(SCREEN_WIDTH, SCREEN_HEIGHT, SP_CELL_SIZE);
-    game->projectiles = new_partitioned_list(SCREEN_WIDTH, SCREEN_HEIGHT, SP_CELL_SIZE);
+    game->aura_towers = queue_new();
+    game->sleeping_towers = queue_new();
+    game->tower_watch = safe_malloc(game->bloon_track.num_buckets, __LINE__);
+    memset(game->tower_watch, 0, game->bloon_track.num_buckets);
+    game->bloons = new_partitioned_list();
+    pool_init(&game->bloon_pool, bloon_slab, sizeof(bloon_t), BLOON_POOL_SIZE);
+    game->bloon_pool.moved = bloon_moved;
+    game->bloon_pool.moved_ctx = game;
+    wheel_init(&game->bloon_timers);
+    game->projectiles = new_partitioned_list();
+    pool_init(&game->projectile_pool, projectile_slab, sizeof(projectile_t),
+              MAX_PROJECTILES);
+    event_queue_init(&game->events, event_slab, MAX_EVENTS);
 
     game->exit = false;
     game->cursor = (position_t){160, 120};
@@ -1883,9 +2200,24 @@ game_t* newGame(position_t* points, size_t num_points) {
 }
 
 void exitGame(game_t* game) {
-    free_partitioned_list(game->bloons, free);
-    free_partitioned_list(game->projectiles, free);
+    dbg_printf("list pool high-water: %d/%d nodes\n",
+               (int)list_pool_high_water(), LIST_POOL_NODES);
+    dbg_printf("bloon pool high-water: %d/%d slots\n",
+               (int)game->bloon_pool.high_water, BLOON_POOL_SIZE);
+    dbg_printf("projectile pool high-water: %d/%d slots\n",
+               (int)game->projectile_pool.high_water, MAX_PROJECTILES);
+    dbg_printf("event queue high-water: %d/%d events\n",
+               (int)game->events.high_water, MAX_EVENTS);
+    dbg_printf("First/Last targets: %d reused, %d scanned\n",
+               (int)game->target_reuses, (int)game->target_scans);
+    free_partitioned_list(game->bloons);
+    free_partitioned_list(game->projectiles);
     queue_free(game->towers, free);
+    queue_free(game->aura_towers, NULL);
+    queue_free(game->sleeping_towers, NULL);
+    free(game->tower_watch);
+    tower_heap_free(&game->tower_schedule);
+    path_index_free(&game->bloon_track);
     freePath(game->path);
     free(game);
 }
@@ -1926,10 +2258,15 @@ uint8_t count_towers(game_t* game) {
 void resetGameState(game_t* game) {
     queue_free(game->towers, free);
     game->towers = queue_new();
-    free_partitioned_list(game->bloons, free);
-    game->bloons = new_partitioned_list(SCREEN_WIDTH, SCREEN_HEIGHT, SP_CELL_SIZE);
-    free_partitioned_list(game->projectiles, free);
-    game->projectiles = new_partitioned_list(SCREEN_WIDTH, SCREEN_HEIGHT, SP_CELL_SIZE);
+    towersChanged(game);
+    free_partitioned_list(game->bloons);
+    game->bloons = new_partitioned_list();
+    pool_clear(&game->bloon_pool);
+    memset(game->bloon_cells, 0, sizeof(game->bloon_cells));
+    wheel_init(&game->bloon_timers);
+    free_partitioned_list(game->projectiles);
+    game->projectiles = new_partitioned_list();
+    pool_clear(&game->projectile_pool);
 
     game->round = 0;
     game->round_active = false;
@@ -1945,10 +2282,14 @@ void resetGameState(game_t* game) {
 }
 
 void clearBloonsAndProjectiles(game_t* game) {
-    free_partitioned_list(game->bloons, free);
-    game->bloons = new_partitioned_list(SCREEN_WIDTH, SCREEN_HEIGHT, SP_CELL_SIZE);
-    free_partitioned_list(game->projectiles, free);
-    game->projectiles = new_partitioned_list(SCREEN_WIDTH, SCREEN_HEIGHT, SP_CELL_SIZE);
+    free_partitioned_list(game->bloons);
+    game->bloons = new_partitioned_list();
+    pool_clear(&game->bloon_pool);
+    memset(game->bloon_cells, 0, sizeof(game->bloon_cells));
+    wheel_init(&game->bloon_timers);
+    free_partitioned_list(game->projectiles);
+    game->projectiles = new_partitioned_list();
+    pool_clear(&game->projectile_pool);
     game->round_active = false;
     game->round_state.complete = true;
 }
@@ -2370,12 +2711,7 @@ void runGame(void) {
                 handleGame(game);
                 /* Fast forward: run a second game tick (no input/draw) */
                 if (game->fast_forward && game->round_active && game->screen == SCREEN_PLAYING) {
-                    spawnBloons(game);
-                    updateProjectiles(game);
-                    updateBloons(game);
-                    updateTowers(game);
-                    checkBloonProjCollissions(game);
-                    checkHitscanPops(game);
+                    stepGame(game);
                 }
                 drawMap(game);
                 drawTowers(game);
@@ -2432,6 +2768,8 @@ int main(void) {
 
     srand(rtc_Time());
 
+    list_pool_init(list_pool_slab, LIST_POOL_NODES);
+
     gfx_Begin();
     gfx_SetPalette(global_palette, sizeof_global_palette, 0);
     gfx_SetTransparentColor(1);
@@ -1,7 +1,9 @@
 #include "path.h"
 
+#include <string.h>
 #include <structs.h>
 
+#include "spacial_partition.h"
 #include "utils.h"
 
 position_t default_path[] = {{0, 113},   {64, 113},  {64, 54},  {140, 54},
@@ -19,6 +21,29 @@ int pathLength(path_t* path) {
     return len;
 }
 
+/**
+ * Walk the path a pixel at a time (positions only change on whole pixels) and
+ * write out each distance where the grid box changes; `out` may be NULL to
+ * just count them
+ */
+static size_t scan_crossings(const path_t* path, int24_t* out) {
+    int24_t d = -(PATH_SPAWN_OFFSET << 8);
+    int24_t end = path->cum_length[path->num_points - 1];
+    uint16_t seg = 0;
+    size_t box = sp_box_at(path_point_at(path, seg, d));
+    size_t n = 0;
+
+    for (d += 256; d < end; d += 256) {
+        seg = path_segment_at(path, d, seg);
+        size_t b = sp_box_at(path_point_at(path, seg, d));
+        if (b == box) continue;
+        if (out != NULL) out[n] = d;
+        n++;
+        box = b;
+    }
+    return n;
+}
+
 /**
  * Build a new path based on an array of points, and a width
  *
@@ -36,6 +61,20 @@ path_t* newPath(position_t* points, size_t num_points, int16_t width) {
     path->points = points;
     path->length = pathLength(path);
 
+    // arc-length table, so a distance along the path maps to a segment
+    // without walking it
+    path->cum_length = safe_malloc(sizeof(int24_t) * num_points, __LINE__);
+    path->cum_length[0] = 0;
+    for (size_t i = 1; i < num_points; i++)
+        path->cum_length[i] = path->cum_length[i - 1] +
+                              ((int24_t)distance(points[i - 1], points[i]) << 8);
+
+    // where the path enters another grid box, so a bloon only needs
+    // re-binning when it passes one
+    path->num_crossings = scan_crossings(path, NULL);
+    path->crossings = safe_malloc(sizeof(int24_t) * (path->num_crossings + 1), __LINE__);
+    scan_crossings(path, path->crossings);
+
     // get rectangles from points
     size_t num_rectangles = num_points - 1;
     path->rectangles =
@@ -68,9 +107,171 @@ path_t* newPath(position_t* points, size_t num_points, int16_t width) {
  */
 void freePath(path_t* path) {
     free(path->rectangles);
+    free(path->cum_length);
+    free(path->crossings);
     free(path);
 }
 
+int24_t path_next_crossing(const path_t* path, int24_t dist) {
+    // binary search for the first crossing > dist
+    size_t lo = 0;
+    size_t hi = path->num_crossings;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (path->crossings[mid] <= dist) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo < path->num_crossings ? path->crossings[lo]
+                                    : path->cum_length[path->num_points - 1];
+}
+
+uint16_t path_segment_at(const path_t* path, int24_t dist, uint16_t seg) {
+    uint16_t end = path->num_points - 1;
+
+    // bloons move a few pixels per frame, so this is almost always 0-1 steps
+    while (seg < end && dist >= path->cum_length[seg + 1]) seg++;
+    while (seg > 0 && dist < path->cum_length[seg]) seg--;
+    return seg;
+}
+
+size_t path_spans_in_circle(const path_t* path, position_t c, int r,
+                            path_span_t* spans, size_t max) {
+    size_t n = 0;
+    for (size_t i = 0; i + 1 < path->num_points; i++) {
+        position_t p = path->points[i];
+        position_t q = path->points[i + 1];
+        double len = (double)((path->cum_length[i + 1] - path->cum_length[i]) >> 8);
+        if (len <= 0) continue;
+
+        // solve |p + t * u - c| = r for t along the unit direction u
+        double ux = (q.x - p.x) / len;
+        double uy = (q.y - p.y) / len;
+        double fx = p.x - c.x;
+        double fy = p.y - c.y;
+        double b = ux * fx + uy * fy;
+        double disc = b * b - (fx * fx + fy * fy - (double)r * r);
+        if (disc < 0) continue;
+
+        double root = sqrt(disc);
+        double t0 = -b - root;
+        double t1 = -b + root;
+        double lo = (i == 0) ? -PATH_SPAWN_OFFSET : 0;
+        if (t0 < lo) t0 = lo;
+        if (t1 > len) t1 = len;
+        if (t0 > t1) continue;
+
+        int24_t from = path->cum_length[i] + (int24_t)floor(t0 - 1) * 256;
+        int24_t to = path->cum_length[i] + (int24_t)ceil(t1 + 1) * 256;
+
+        if (n > 0 && ((from >> PATH_BUCKET_SHIFT) <= (spans[n - 1].to >> PATH_BUCKET_SHIFT) ||
+                      n == max)) {
+            // joins the previous span, or there's no room for another
+            if (to > spans[n - 1].to) spans[n - 1].to = to;
+            continue;
+        }
+        spans[n].from = from;
+        spans[n].to = to;
+        n++;
+    }
+    return n;
+}
+
+void path_index_init(path_index_t* track, const path_t* path, size_t capacity) {
+    track->num_buckets = (size_t)(path->cum_length[path->num_points - 1] >> PATH_BUCKET_SHIFT) + 1;
+    track->capacity = capacity;
+    track->count = 0;
+    track->order = safe_malloc(sizeof(bloon_t*) * capacity, __LINE__);
+    track->start = safe_malloc(sizeof(size_t) * (track->num_buckets * SP_LANES + 1), __LINE__);
+    memset(track->start, 0, sizeof(size_t) * (track->num_buckets * SP_LANES + 1));
+}
+
+void path_index_free(path_index_t* track) {
+    free(track->order);
+    free(track->start);
+}
+
+/* Bucket and lane of a bloon, as one sort key */
+static inline size_t track_key(const path_index_t* track, const bloon_t* bloon) {
+    return path_bucket_of(track, bloon->dist) * SP_LANES + bloon->link.lane;
+}
+
+/* Does `a` belong after `b` in the order? */
+static inline bool track_after(const path_index_t* track, const bloon_t* a,
+                               const bloon_t* b) {
+    size_t ka = track_key(track, a);
+    size_t kb = track_key(track, b);
+    return ka > kb || (ka == kb && a->dist > b->dist);
+}
+
+void path_index_rebuild(path_index_t* track, pool_t* bloons) {
+    bloon_t** order = track->order;
+    size_t n = track->count;
+
+    // re-point last tick's slots (sp_compact may have moved the bloons);
+    // slots of bloons that died stay NULL
+    memset(order, 0, sizeof(bloon_t*) * n);
+    for (size_t i = 0; i < bloons->count; i++) {
+        bloon_t* bloon = pool_at(bloons, i);
+        if (sp_linked(&bloon->link) && bloon->track_slot != 0)
+            order[bloon->track_slot - 1] = bloon;
+    }
+
+    // close the gaps, then append bloons that arrived since
+    size_t m = 0;
+    for (size_t i = 0; i < n; i++)
+        if (order[i] != NULL) order[m++] = order[i];
+    for (size_t i = 0; i < bloons->count; i++) {
+        bloon_t* bloon = pool_at(bloons, i);
+        if (sp_linked(&bloon->link) && bloon->track_slot == 0) order[m++] = bloon;
+    }
+
+    // insertion sort: only overtakes, bucket crossings and new arrivals move
+    for (size_t i = 1; i < m; i++) {
+        bloon_t* bloon = order[i];
+        size_t j = i;
+        while (j > 0 && track_after(track, order[j - 1], bloon)) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = bloon;
+    }
+
+    // remember each bloon's slot, and where each key starts
+    size_t keys = track->num_buckets * SP_LANES;
+    size_t* start = track->start;
+    size_t k = 0;
+    for (size_t i = 0; i < m; i++) {
+        order[i]->track_slot = (uint8_t)(i + 1);
+        size_t key = track_key(track, order[i]);
+        while (k <= key) start[k++] = i;
+    }
+    while (k <= keys) start[k++] = m;
+    track->count = m;
+}
+
+position_t path_point_at(const path_t* path, uint16_t seg, int24_t dist) {
+    if (seg >= path->num_points - 1) return path->points[path->num_points - 1];
+
+    position_t p = path->points[seg];
+    position_t q = path->points[seg + 1];
+    int off = (int)((dist - path->cum_length[seg]) >> 8);
+
+    if (p.y == q.y) {
+        p.x += (q.x > p.x) ? off : -off;
+    } else if (p.x == q.x) {
+        p.y += (q.y > p.y) ? off : -off;
+    } else {
+        // diagonal: interpolate by the fraction of the segment covered
+        int len = (int)((path->cum_length[seg + 1] - path->cum_length[seg]) >> 8);
+        p.x += (q.x - p.x) * off / len;
+        p.y += (q.y - p.y) * off / len;
+    }
+    return p;
+}
+
 void drawGamePath(game_t* game) {
     path_t* path = game->path;
     dbg_printf("Drawing path...\n");
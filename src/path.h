@@ -11,11 +11,63 @@ extern "C" {
 #include "structs.h"
 
 #define DEFAULT_PATH_WIDTH 20  // path width in pixels
+#define PATH_SPAWN_OFFSET 16   // bloons enter this many pixels before points[0]
+#define PATH_BUCKET_SHIFT 12   // path_index_t buckets are 16 px (dist is x256)
 
 int pathLength(path_t* path);
 
 path_t* newPath(position_t* points, size_t num_points, int16_t width);
 
+/// @brief Segment containing `dist` (fixed-point x256 along the path), found
+/// by stepping from the segment `seg` it was last in
+/// @return num_points - 1 once `dist` is past the end of the path
+uint16_t path_segment_at(const path_t* path, int24_t dist, uint16_t seg);
+
+/// @brief Point `dist` along the path, which lies in segment `seg`; negative
+/// distances extend the first segment backwards
+position_t path_point_at(const path_t* path, uint16_t seg, int24_t dist);
+
+/// @brief First entry of path->crossings past `dist`
+/// @return the length of the path if there is none
+int24_t path_next_crossing(const path_t* path, int24_t dist);
+
+/// @brief Find the stretches of path within `r` of `c`, widened by a pixel
+/// for rounding. Stretches sharing a bucket are merged, and past `max` the
+/// last one is stretched to cover the rest.
+/// @return number of spans written
+size_t path_spans_in_circle(const path_t* path, position_t c, int r,
+                            path_span_t* spans, size_t max);
+
+/// @brief Size a path index for `capacity` bloons on `path`
+void path_index_init(path_index_t* track, const path_t* path, size_t capacity);
+
+void path_index_free(path_index_t* track);
+
+/// @brief Bring the order up to date with `bloons`: drop dead bloons, append
+/// new ones and insertion-sort the result, which is close to linear since
+/// bloons rarely overtake each other. Call after the pass that moves them,
+/// before querying; pointers go stale at the next sp_compact, but each bloon
+/// remembers its slot so the next rebuild can pick the order back up.
+void path_index_rebuild(path_index_t* track, pool_t* bloons);
+
+/// @brief Bucket holding distance `dist` (clamped to the path)
+static inline size_t path_bucket_of(const path_index_t* track, int24_t dist) {
+    if (dist < 0) return 0;
+    size_t b = (size_t)(dist >> PATH_BUCKET_SHIFT);
+    return b < track->num_buckets ? b : track->num_buckets - 1;
+}
+
+/// @brief Loop `it` (a bloon_t*) over the linked bloons in lanes 0 .. `last`
+/// of bucket `i`, lane by lane in increasing distance
+#define PATH_BUCKET_FOR_EACH(track, i, last, it)                            \
+    for (bloon_t **it##_p = (track)->order + (track)->start[(i) * SP_LANES],\
+                 **it##_end =                                               \
+                     (track)->order + (track)->start[(i) * SP_LANES + (last) + 1], \
+                 *it;                                                       \
+         it##_p < it##_end && ((it = *it##_p), 1); it##_p++)               \
+        if (!sp_linked(&it->link)) {                                        \
+        } else
+
 void freePath(path_t* path);
 
 void drawGamePath(game_t* game);
@@ -0,0 +1,28 @@
+#include "pool.h"
+
+#include <debug.h>
+#include <string.h>
+
+void pool_init(pool_t *p, void *slab, size_t stride, size_t capacity) {
+    p->items = slab;
+    p->stride = stride;
+    p->capacity = (slab == NULL) ? 0 : capacity;
+    p->count = 0;
+    p->high_water = 0;
+    p->moved = NULL;
+    p->moved_ctx = NULL;
+}
+
+void *pool_claim(pool_t *p) {
+    if (p->count >= p->capacity) {
+        dbg_printf("pool full (%d slots)\n", (int)p->capacity);
+        return NULL;
+    }
+
+    void *slot = pool_at(p, p->count);
+    memset(slot, 0, p->stride);
+    if (++p->count > p->high_water) p->high_water = p->count;
+    return slot;
+}
+
+void pool_clear(pool_t *p) { p->count = 0; }
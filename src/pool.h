@@ -0,0 +1,53 @@
+#ifndef POOL_H
+#define POOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/*
+Fixed-capacity store of same-sized entities packed at the front of a slab.
+Slots [0, count) are claimed; walking them is a dense sweep over contiguous
+memory instead of a pointer chase. Slots never move while they are claimed,
+so entity pointers stay valid until the owner packs the store again (see
+sp_compact, which swap-removes dead entities once per tick); `moved` lets an
+entity that others point at fix those pointers up when it is moved.
+*/
+typedef struct {
+    uint8_t *items;      // slab of capacity * stride bytes
+    size_t stride;       // size of one entity
+    size_t capacity;     // number of slots in items
+    size_t count;        // claimed slots, always packed at the front
+    size_t high_water;   // most slots ever claimed at once
+    void (*moved)(void *ctx, void *slot);  // called on an entity moved into `slot` (may be NULL)
+    void *moved_ctx;
+} pool_t;
+
+/// @brief Hand a slab of `capacity` entities of `stride` bytes to the pool
+void pool_init(pool_t *p, void *slab, size_t stride, size_t capacity);
+
+/// @brief Claim a zeroed slot at the end of the pool
+/// @return `NULL` if the pool is full
+void *pool_claim(pool_t *p);
+
+/// @brief Drop every slot without touching the slab
+void pool_clear(pool_t *p);
+
+/// @brief Pointer to slot `i` (must be < count)
+static inline void *pool_at(pool_t *p, size_t i) {
+    return p->items + i * p->stride;
+}
+
+/// @brief Slot of an entity in the pool
+static inline size_t pool_index(const pool_t *p, const void *item) {
+    return (size_t)((const uint8_t *)item - p->items) / p->stride;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
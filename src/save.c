@@ -10,7 +10,8 @@
 #include "utils.h"
 
 /* Apply upgrades from TOWER_DATA base + purchased upgrade deltas */
-extern void apply_upgrades(tower_t* tower);
+extern void apply_upgrades(game_t* game, tower_t* tower);
+extern void towersChanged(game_t* game);
 
 bool save_game(game_t* game) {
     ti_var_t slot = ti_Open(SAVE_APPVAR_NAME, "w");
@@ -107,6 +108,7 @@ bool load_game(game_t* game) {
         tower_save_t ts;
         if (ti_Read(&ts, sizeof(tower_save_t), 1, slot) != 1) {
             dbg_printf("load_game: failed to read tower %d\n", i);
+            towersChanged(game);
             ti_Close(slot);
             return false;
         }
@@ -121,7 +123,7 @@ bool load_game(game_t* game) {
         tower->target_mode = ts.target_mode;
 
         /* Compute effective stats from base + upgrades */
-        apply_upgrades(tower);
+        apply_upgrades(game, tower);
 
         /* Calculate total invested for sell value (with difficulty multiplier, wiki rounding) */
         {
@@ -148,6 +150,7 @@ bool load_game(game_t* game) {
 
         queue_insert_head(game->towers, (void*)tower);
     }
+    towersChanged(game);
 
     ti_Close(slot);
 
@@ -2,128 +2,315 @@
 
 #include <debug.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "list.h"
 #include "structs.h"
 
-size_t ceil_st(size_t a, size_t b) { return (a + b - 1) / b; }
+size_t sp_box_of(multi_list_t *l, position_t p) {
+    (void)l;
+    return sp_box_at(p);
+}
 
-static inline size_t sp_box_index(multi_list_t *l, position_t p) {
+size_t sp_box_at(position_t p) {
     // negative coordinates are out of bounds
-    if (p.x < 0 || p.y < 0) return l->num_boxes_in_range;
+    if (p.x < 0 || p.y < 0) return SP_OUT_OF_RANGE;
 
     // find which box the position is in
-    size_t box_col = (size_t)p.x / l->box_size;
-    size_t box_row = (size_t)p.y / l->box_size;
+    unsigned box_col = SP_CELL_OF(p.x);
+    unsigned box_row = SP_CELL_OF(p.y);
 
-    if (box_row < l->height && box_col < l->width) {
+    if (box_row < SP_GRID_ROWS && box_col < SP_GRID_COLS) {
         // in bounds
-        return (box_row * l->width) + box_col;
+        return (box_row * SP_GRID_COLS) + box_col;
     }
 
     // out of bounds
-    return l->num_boxes_in_range;
+    return SP_OUT_OF_RANGE;
 }
 
-multi_list_t *new_partitioned_list(size_t width, size_t height,
-                                   size_t box_size) {
+multi_list_t *new_partitioned_list(void) {
     multi_list_t *multi_l = malloc(sizeof(multi_list_t));
     multi_l->total_size = 0UL;
-    multi_l->box_size = box_size;
-    multi_l->height = ceil_st(height, box_size);
-    multi_l->width = ceil_st(width, box_size);
-
-    // list of all inited boxes
-    multi_l->inited_boxes = queue_new();
-
-    // array of (lazily created) boxes for O(1) position => box lookup
-    multi_l->num_boxes_in_range = (multi_l->height * multi_l->width);
 
     // create an additional box for out-of-range positions
-    multi_l->n = multi_l->num_boxes_in_range + 1;
-    multi_l->boxes = calloc(sizeof(queue_t *), multi_l->n);
+    multi_l->n = SP_MAX_CELLS;
+    memset(multi_l->occupied, 0, sizeof(multi_l->occupied));
+
+#ifdef SP_REBUILD
+    // every box starts out empty; order is sized on the first rebuild
+    multi_l->order = NULL;
+    multi_l->order_cap = 0;
+    multi_l->start = calloc(sizeof(size_t), multi_l->n * SP_LANES + 1);
+#else
+    // array of boxes (one chain per lane) for O(1) position => box lookup
+    multi_l->boxes = calloc(sizeof(sp_box_t), multi_l->n * SP_LANES);
+#endif
 
     return multi_l;
 }
 
-void free_partitioned_list(multi_list_t *free_me, void (*freer)(void *)) {
-    // free boxes
-    queue_t *curr_q;
-    for (size_t i = 0; i < free_me->n; i++) {
-        if ((curr_q = (free_me->boxes)[i]) != NULL) queue_free(curr_q, freer);
-    }
-
+void free_partitioned_list(multi_list_t *free_me) {
+#ifdef SP_REBUILD
+    free(free_me->order);
+    free(free_me->start);
+#else
     // free array
     free(free_me->boxes);
-
-    // free inited_boxes (list of boxes)
-    queue_free(free_me->inited_boxes, NULL);
+#endif
 
     free(free_me);
 }
 
-queue_t *sp_hard_get_list(multi_list_t *l, position_t p) {
-    size_t box_ind = sp_box_index(l, p);
+size_t sp_total_size(multi_list_t *l) { return l->total_size; }
 
-    // lazily create boxes
-    queue_t *box = l->boxes[box_ind];
-    if (box == NULL) {
-        box = queue_new();
-        l->boxes[box_ind] = box;
-        queue_insert_head(l->inited_boxes, box);
+/* Clip the pixel span [lo, hi] to the `count` boxes along one axis; sets
+ * [*first, *last] (empty if first > last) and returns whether the span
+ * reaches outside the grid */
+static bool sp_clip_span(int lo, int hi, int count, int *first, int *last) {
+    int limit = SP_CELL_SIZE * count - 1;
+    bool outside = lo < 0 || hi > limit;
+
+    if (hi < 0 || lo > limit) {
+        *first = 1;
+        *last = 0;
+        return outside;
     }
+    if (lo < 0) lo = 0;
+    if (hi > limit) hi = limit;
+    *first = (int)SP_CELL_OF(lo);
+    *last = (int)SP_CELL_OF(hi);
+    return outside;
+}
 
-    return box;
+/* Shared by the rect and circle queries; `r` < 0 skips the per-box circle
+ * test so every box in the rectangle is marked */
+static void sp_mark_boxes(int x0, int y0, int x1, int y1, position_t c, int r,
+                          uint8_t *mask) {
+    const int bs = SP_CELL_SIZE;
+    int col0, col1, row0, row1;
+    bool outside = sp_clip_span(x0, x1, SP_GRID_COLS, &col0, &col1);
+    outside |= sp_clip_span(y0, y1, SP_GRID_ROWS, &row0, &row1);
+
+    memset(mask, 0, SP_MASK_BYTES);
+    for (int row = row0; row <= row1; row++) {
+        for (int col = col0; col <= col1; col++) {
+            if (r >= 0) {
+                // nearest point of the box to the center
+                int nx = c.x < col * bs ? col * bs
+                       : c.x >= (col + 1) * bs ? (col + 1) * bs - 1 : c.x;
+                int ny = c.y < row * bs ? row * bs
+                       : c.y >= (row + 1) * bs ? (row + 1) * bs - 1 : c.y;
+                int dx = nx - c.x;
+                int dy = ny - c.y;
+                if (dx * dx + dy * dy > r * r) continue;
+            }
+            sp_mask_set(mask, (size_t)row * SP_GRID_COLS + (size_t)col);
+        }
+    }
+    if (outside) sp_mask_set(mask, SP_OUT_OF_RANGE);
 }
 
-queue_t *sp_soft_get_list(multi_list_t *l, position_t p) {
-    return l->boxes[sp_box_index(l, p)];
+void sp_query_rect(multi_list_t *l, int x0, int y0, int x1, int y1,
+                   uint8_t mask[SP_MASK_BYTES]) {
+    position_t unused = {0, 0};
+    sp_mark_boxes(x0, y0, x1, y1, unused, -1, mask);
+    sp_mask_and(mask, mask, l->occupied);
 }
 
-// to see if insertion was successful, check if total size changed
-void sp_insert(multi_list_t *l, position_t p, void *v) {
-    queue_t *box = sp_hard_get_list(l, p);
-    queue_insert_head(box, v);
+void sp_query_circle(multi_list_t *l, position_t c, int r,
+                     uint8_t mask[SP_MASK_BYTES]) {
+    sp_mark_boxes(c.x - r, c.y - r, c.x + r, c.y + r, c, r, mask);
+    sp_mask_and(mask, mask, l->occupied);
+}
+
+#ifdef SP_REBUILD
+
+/* ── Rebuild backend ── */
+
+void sp_insert(multi_list_t *l, position_t p, sp_link_t *link) {
+    link->box = (uint8_t)sp_box_of(l, p);
     l->total_size++;
 }
 
-void sp_remove(multi_list_t *l, position_t p, list_ele_t *elem,
-               void (*freer)(void *)) {
-    // NO-OP if list doesn't exist yet
-    queue_t *box = sp_soft_get_list(l, p);
-    if (box == NULL) return;
+void sp_remove(multi_list_t *l, sp_link_t *link) {
+    // NO-OP if the element isn't in a box
+    if (link->box == SP_NO_BOX) return;
 
-    size_t old_box_size = queue_size(box);
-    remove_and_delete(box, elem, freer);
-    l->total_size = (l->total_size - old_box_size + queue_size(box));
+    // stays in `order` until the next rebuild, where queries skip it
+    link->box = SP_NO_BOX;
+    l->total_size--;
 }
 
-void sp_fix(multi_list_t *l, list_ele_t *elem, position_t old_pos,
-            position_t new_pos) {
-    queue_t *old_box = sp_soft_get_list(l, old_pos);
-    queue_t *new_box = sp_soft_get_list(l, new_pos);
+void sp_fix(multi_list_t *l, sp_link_t *link, position_t new_pos) {
+    if (link->box == SP_NO_BOX) return;
+    link->box = (uint8_t)sp_box_of(l, new_pos);
+}
 
-    // no need to do anything, since it will be in the same box
-    if (old_box != NULL && old_box == new_box) return;
+void sp_set_lane(multi_list_t *l, sp_link_t *link, uint8_t lane) {
+    // regrouped on the next rebuild
+    (void)l;
+    link->lane = lane;
+}
+
+/* Sort key of an element: lanes of a box are adjacent, lane 0 first */
+static inline size_t sp_key(const sp_link_t *link) {
+    return (size_t)link->box * SP_LANES + link->lane;
+}
+
+void sp_rebuild(multi_list_t *l, pool_t *p) {
+    if (l->order_cap < p->capacity) {
+        free(l->order);
+        l->order = malloc(sizeof(sp_link_t *) * p->capacity);
+        l->order_cap = p->capacity;
+    }
+
+    size_t keys = l->n * SP_LANES;
+    size_t *start = l->start;
+    memset(start, 0, sizeof(size_t) * (keys + 1));
+
+    // histogram: start[k + 1] counts key k
+    for (size_t i = 0; i < p->count; i++) {
+        sp_link_t *link = pool_at(p, i);
+        if (sp_linked(link)) start[sp_key(link) + 1]++;
+    }
+
+    // exclusive prefix sum: start[k + 1] becomes the first slot of key k
+    memset(l->occupied, 0, sizeof(l->occupied));
+    size_t sum = 0;
+    for (size_t k = 0; k < keys; k++) {
+        size_t count = start[k + 1];
+        if (count != 0) sp_mask_set(l->occupied, k / SP_LANES);
+        start[k + 1] = sum;
+        sum += count;
+    }
+
+    // scatter: bumping start[k + 1] past key k leaves it at the end of key k
+    for (size_t i = 0; i < p->count; i++) {
+        sp_link_t *link = pool_at(p, i);
+        if (sp_linked(link)) l->order[start[sp_key(link) + 1]++] = link;
+    }
+}
+
+void sp_compact(multi_list_t *l, pool_t *p) {
+    size_t i = 0;
+    while (i < p->count) {
+        sp_link_t *slot = pool_at(p, i);
+        if (sp_linked(slot)) {
+            i++;
+            continue;
+        }
+
+        // fill the hole with the last slot (which may itself be dead, in
+        // which case this slot is checked again)
+        p->count--;
+        if (i == p->count) break;
+        memcpy(slot, pool_at(p, p->count), p->stride);
+        if (sp_linked(slot) && p->moved != NULL) p->moved(p->moved_ctx, slot);
+    }
+
+    // `order` points at the old slots; nothing is queryable until a rebuild
+    memset(l->start, 0, sizeof(size_t) * (l->n * SP_LANES + 1));
+    memset(l->occupied, 0, sizeof(l->occupied));
+}
+
+#else
+
+/* ── Linked backend ── */
+
+/* Chain of the lane `link` belongs to in box `box_ind` */
+static inline sp_box_t *sp_chain(multi_list_t *l, size_t box_ind,
+                                 const sp_link_t *link) {
+    return &l->boxes[box_ind * SP_LANES + link->lane];
+}
+
+static inline void sp_link_head(multi_list_t *l, size_t box_ind,
+                                sp_link_t *link) {
+    sp_box_t *box = sp_chain(l, box_ind, link);
+    if (sp_box_size(l, box_ind) == 0) sp_mask_set(l->occupied, box_ind);
+
+    link->box = (uint8_t)box_ind;
+    link->prev = NULL;
+    link->next = box->head;
+    if (box->head != NULL) box->head->prev = link;
+    box->head = link;
+    box->size++;
+}
+
+static inline void sp_unlink(multi_list_t *l, sp_link_t *link) {
+    sp_box_t *box = sp_chain(l, link->box, link);
+
+    if (link->prev != NULL) {
+        link->prev->next = link->next;
+    } else {
+        box->head = link->next;
+    }
+    if (link->next != NULL) link->next->prev = link->prev;
+    box->size--;
+    if (sp_box_size(l, link->box) == 0) sp_mask_clear(l->occupied, link->box);
+    link->box = SP_NO_BOX;
+}
+
+void sp_insert(multi_list_t *l, position_t p, sp_link_t *link) {
+    sp_link_head(l, sp_box_of(l, p), link);
+    l->total_size++;
+}
+
+void sp_remove(multi_list_t *l, sp_link_t *link) {
+    // NO-OP if the element isn't in a box
+    if (link->box == SP_NO_BOX) return;
 
-    void *v = elem->value;
-    sp_insert(l, new_pos, v);
-    sp_remove(l, old_pos, elem, NULL);
+    sp_unlink(l, link);
+    l->total_size--;
 }
 
-void sp_fix_box(multi_list_t *l, queue_t *old_box, list_ele_t *elem,
-                position_t new_pos) {
-    queue_t *new_box = sp_soft_get_list(l, new_pos);
+void sp_fix(multi_list_t *l, sp_link_t *link, position_t new_pos) {
+    size_t new_ind = sp_box_of(l, new_pos);
 
     // no need to do anything, since it will be in the same box
-    if (old_box != NULL && old_box == new_box) return;
+    if (link->box == SP_NO_BOX || link->box == new_ind) return;
 
-    void *v = elem->value;
-    sp_insert(l, new_pos, v);
+    sp_unlink(l, link);
+    sp_link_head(l, new_ind, link);
+}
 
-    size_t old_box_size = queue_size(old_box);
-    remove_and_delete(old_box, elem, NULL);
-    l->total_size = (l->total_size - old_box_size + queue_size(old_box));
+void sp_set_lane(multi_list_t *l, sp_link_t *link, uint8_t lane) {
+    if (link->box == SP_NO_BOX || link->lane == lane) {
+        link->lane = lane;
+        return;
+    }
+
+    size_t box_ind = link->box;
+    sp_unlink(l, link);
+    link->lane = lane;
+    sp_link_head(l, box_ind, link);
 }
 
-size_t sp_total_size(multi_list_t *l) { return l->total_size; }
+void sp_compact(multi_list_t *l, pool_t *p) {
+    size_t i = 0;
+    while (i < p->count) {
+        sp_link_t *slot = pool_at(p, i);
+        if (sp_linked(slot)) {
+            i++;
+            continue;
+        }
+
+        // fill the hole with the last slot (which may itself be dead, in
+        // which case this slot is checked again)
+        p->count--;
+        if (i == p->count) break;
+        sp_link_t *last = pool_at(p, p->count);
+        memcpy(slot, last, p->stride);
+        if (!sp_linked(slot)) continue;
+
+        if (slot->prev != NULL) {
+            slot->prev->next = slot;
+        } else {
+            sp_chain(l, slot->box, slot)->head = slot;
+        }
+        if (slot->next != NULL) slot->next->prev = slot;
+        if (p->moved != NULL) p->moved(p->moved_ctx, slot);
+    }
+}
+
+#endif
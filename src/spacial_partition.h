@@ -8,43 +8,196 @@ extern "C" {
 #include <stdlib.h>
 
 #include "list.h"
+#include "pool.h"
 #include "structs.h"
 
-/// @brief Create a new spatially partitioned list
-/// @param width width of space
-/// @param height height of space
-/// @param box_size the length of square boxes which space is tiled with
-/// @return
-multi_list_t *new_partitioned_list(size_t width, size_t height,
-                                   size_t box_size);
+/* Elements embed an sp_link_t as their first member and live in a pool_t.
+ * There are two backends, picked at compile time:
+ *
+ * - default: every box is an intrusive doubly-linked chain that sp_fix keeps
+ *   up to date as elements move.
+ * - SP_REBUILD: sp_fix only records the new box; sp_rebuild then counting-sorts
+ *   the whole pool into one flat array once per tick, so each box is a
+ *   contiguous run. Elements inserted since the last rebuild aren't visible to
+ *   box queries until the next one.
+ *
+ * Both are queried the same way, through sp_box_of / sp_box_size /
+ * SP_BOX_FOR_EACH, and both keep `occupied` (one bit per non-empty box) so
+ * whole-grid passes can skip empty boxes with SP_MASK_FOR_EACH.
+ *
+ * Each box is split into SP_LANES lanes by sp_link_t::lane and walked lane 0
+ * first, so a query that only wants lane 0 (SP_BOX_FOR_EACH_UPTO) never
+ * touches the rest. Set the lane before inserting; sp_set_lane moves an
+ * element between the lanes of its box.
+ *
+ * Range queries fill a box mask to walk the same way:
+ *
+ *     uint8_t boxes[SP_MASK_BYTES];
+ *     sp_query_circle(l, center, radius, boxes);
+ *     SP_MASK_FOR_EACH(boxes, l->n, b) {
+ *         SP_BOX_FOR_EACH(l, b, it) { ... distance test it ... }
+ *     }
+ */
 
-void free_partitioned_list(multi_list_t *free_me, void (*freer)(void *));
+#define SP_NO_BOX 0xFF  // sp_link_t::box of an element that isn't in a list
 
-/// @brief Get the list which this position corresponds to
-/// @return `NULL` if the position is out of bounds; if the position is in
-/// bounds it creates an empty list
-queue_t *sp_hard_get_list(multi_list_t *l, position_t p);
+#if SP_MAX_CELLS >= SP_NO_BOX
+#error "SP_CELL_SIZE is too small for a uint8_t box index"
+#endif
+
+/// @brief Create a new spatially partitioned list covering the screen in
+/// SP_CELL_SIZE boxes
+multi_list_t *new_partitioned_list(void);
+
+/// @brief Free the list (the elements belong to their pool)
+void free_partitioned_list(multi_list_t *free_me);
 
-/// @brief Get the list which this position corresponds to
-/// @return `NULL` if a list hasn't been instantiated or the position is out of
-/// bounds
-queue_t *sp_soft_get_list(multi_list_t *l, position_t p);
+/// @brief Index of the box which this position corresponds to
+/// @return out-of-bounds positions all share box SP_OUT_OF_RANGE
+size_t sp_box_of(multi_list_t *l, position_t p);
 
-void sp_insert(multi_list_t *l, position_t p, void *data);
+/// @brief sp_box_of without a list, since every list has the same geometry
+size_t sp_box_at(position_t p);
 
-void sp_remove(multi_list_t *l, position_t p, list_ele_t *elem,
-               void (*freer)(void *));
+/// @brief Link an element into the box for `p`
+void sp_insert(multi_list_t *l, position_t p, sp_link_t *link);
 
-void sp_fix(multi_list_t *l, list_ele_t *elem, position_t old_pos,
-            position_t new_pos);
+/// @brief Unlink an element from its box (NO-OP if it isn't in one)
+void sp_remove(multi_list_t *l, sp_link_t *link);
 
-void sp_fix_box(multi_list_t *l, queue_t *old_box, list_ele_t *elem,
-                position_t new_pos);
+/// @brief Move an element into the box for `new_pos` if it has left its box
+void sp_fix(multi_list_t *l, sp_link_t *link, position_t new_pos);
+
+/// @brief Move an element to another lane of its box
+void sp_set_lane(multi_list_t *l, sp_link_t *link, uint8_t lane);
 
 size_t sp_total_size(multi_list_t *l);
 
+/// @brief Is this element currently linked into a box?
+static inline bool sp_linked(const sp_link_t *link) {
+    return link->box != SP_NO_BOX;
+}
+
+/// @brief Mark box `i` in a one-bit-per-box mask
+static inline void sp_mask_set(uint8_t *mask, size_t i) {
+    mask[i >> 3] |= (uint8_t)(1 << (i & 7));
+}
+
+/// @brief Unmark box `i` in a one-bit-per-box mask
+static inline void sp_mask_clear(uint8_t *mask, size_t i) {
+    mask[i >> 3] &= (uint8_t)~(1 << (i & 7));
+}
+
+/// @brief dst = a & b, one box mask at a time (dst may alias a or b)
+static inline void sp_mask_and(uint8_t *dst, const uint8_t *a,
+                               const uint8_t *b) {
+    for (int i = 0; i < SP_MASK_BYTES; i++) dst[i] = a[i] & b[i];
+}
+
+/// @brief First marked box at or after `from` in `mask`
+/// @return `n` if there is none; whole empty bytes are skipped at once
+static inline size_t sp_mask_next(const uint8_t *mask, size_t from, size_t n) {
+    while (from < n) {
+        uint8_t byte = mask[from >> 3] >> (from & 7);
+        if (byte == 0) {
+            from = (from | 7) + 1;
+            continue;
+        }
+        while (!(byte & 1)) {
+            byte >>= 1;
+            from++;
+        }
+        return from < n ? from : n;
+    }
+    return n;
+}
+
+/// @brief Loop box index `b` (a size_t) over every set bit of `mask` below `n`
+#define SP_MASK_FOR_EACH(mask, n, b)                                        \
+    for (size_t b = sp_mask_next((mask), 0, (n)); b < (n);                  \
+         b = sp_mask_next((mask), b + 1, (n)))
+
+/// @brief Mark the occupied boxes overlapping the rectangle [x0, x1] x [y0, y1]
+/// (inclusive, in pixels); the out-of-range box is included if the rectangle
+/// reaches past the grid
+void sp_query_rect(multi_list_t *l, int x0, int y0, int x1, int y1,
+                   uint8_t mask[SP_MASK_BYTES]);
+
+/// @brief Mark the occupied boxes overlapping the circle of radius `r` around
+/// `c`; the out-of-range box is included if the circle reaches past the grid
+void sp_query_circle(multi_list_t *l, position_t c, int r,
+                     uint8_t mask[SP_MASK_BYTES]);
+
+/// @brief Pack a pool whose entities live in `l`: every slot that is no longer
+/// linked is filled by swap-removing the last slot, calling the pool's `moved`
+/// hook on it. Invalidates entity pointers (and, under SP_REBUILD, empties
+/// every box until the next rebuild).
+void sp_compact(multi_list_t *l, pool_t *p);
+
+#ifdef SP_REBUILD
+
+/// @brief Regroup every linked element of `p` by box and lane (histogram,
+/// prefix sum, scatter) and recompute `occupied`. Call after the pass that
+/// moves the elements, before querying. Until the next rebuild, `occupied` may
+/// still mark boxes whose elements have all been removed, and sp_set_lane
+/// moves don't show up in lane order.
+void sp_rebuild(multi_list_t *l, pool_t *p);
+
+/// @brief Number of entries in box `i` (may include elements removed since
+/// the last rebuild)
+static inline size_t sp_box_size(multi_list_t *l, size_t i) {
+    return l->start[(i + 1) * SP_LANES] - l->start[i * SP_LANES];
+}
+
+/// @brief Loop `it` (an sp_link_t*) over the elements in lanes 0 .. `last` of
+/// box `i`; safe to sp_remove `it` inside the body
+#define SP_BOX_FOR_EACH_UPTO(l, i, last, it)                                \
+    for (sp_link_t **it##_p = (l)->order + (l)->start[(i) * SP_LANES],      \
+                   **it##_end =                                             \
+                       (l)->order + (l)->start[(i) * SP_LANES + (last) + 1],\
+                   *it;                                                     \
+         it##_p < it##_end && ((it = *it##_p), 1); it##_p++)               \
+        if (!sp_linked(it)) {                                               \
+        } else
+
+#else
+
+/// @brief Nothing to do: the boxes are kept current by sp_fix
+static inline void sp_rebuild(multi_list_t *l, pool_t *p) {
+    (void)l;
+    (void)p;
+}
+
+/// @brief Number of elements in box `i`
+static inline size_t sp_box_size(multi_list_t *l, size_t i) {
+    return l->boxes[i * SP_LANES].size + l->boxes[i * SP_LANES + 1].size;
+}
+
+/// @brief Loop `it` (an sp_link_t*) over the elements in lanes 0 .. `last` of
+/// box `i`; safe to sp_remove `it` inside the body. Lane 1's head is read up
+/// front, so elements inserted during the loop aren't visited.
+#define SP_BOX_FOR_EACH_UPTO(l, i, last, it)                                \
+    for (sp_link_t *it##_lane1 =                                            \
+                       (last) ? (l)->boxes[(i) * SP_LANES + 1].head : NULL, \
+                   *it = (l)->boxes[(i) * SP_LANES].head != NULL            \
+                             ? (l)->boxes[(i) * SP_LANES].head              \
+                             : it##_lane1,                                  \
+                   *it##_next;                                              \
+         it != NULL &&                                                      \
+         ((it##_next = it->next != NULL ? it->next                          \
+                       : it->lane == 0  ? it##_lane1                        \
+                                        : NULL),                            \
+          1);                                                               \
+         it = it##_next)
+
+#endif
+
+/// @brief Loop `it` (an sp_link_t*) over every element in box `i`; safe to
+/// sp_remove `it` inside the body
+#define SP_BOX_FOR_EACH(l, i, it) SP_BOX_FOR_EACH_UPTO(l, i, SP_LANES - 1, it)
+
 #ifdef __cplusplus
 }
 #endif
 
-#endif
\ No newline at end of file
+#endif
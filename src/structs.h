@@ -11,6 +11,7 @@ extern "C" {
 #include <stdlib.h>
 
 #include "list.h"
+#include "pool.h"
 
 /*
 Point on the canvas
@@ -36,37 +37,136 @@ typedef struct {
 typedef struct {
     position_t* points;  // the points which make up the piecewise path
     rectangle_t* rectangles;
+    int24_t* cum_length; // distance from points[0] to points[i] (fixed-point x256)
+    int24_t* crossings; // ascending distances at which the path enters another grid box
+    size_t num_crossings; // length of crossings
     size_t num_points;  // length of points
     int length;         // sum of lengths of line segments
     int width;          // width of the path
 } path_t;
 
+/*
+Intrusive link into a spatial partition (multi_list_t). It must be the first
+member of anything stored in one, so a link pointer is also the entity pointer.
+*/
+typedef struct sp_link {
+#ifndef SP_REBUILD
+    struct sp_link* prev;
+    struct sp_link* next;
+#endif
+    uint8_t box;            // index of the owning box in multi_list_t::boxes
+    uint8_t lane;           // 0 or 1; queries can stop after lane 0
+} sp_link_t;
+
+typedef struct {
+    sp_link_t* head;
+    size_t size;
+} sp_box_t;
+
+/*
+The grid covers the screen and its geometry is fixed at compile time, so box
+lookups are constant folded. With a power-of-two SP_CELL_SIZE (e.g.
+-DSP_CELL_SIZE=32) they are shifts; any other size, such as the default 40,
+falls back to division.
+*/
+#ifndef SP_CELL_SIZE
+#define SP_CELL_SIZE 40
+#endif
+
+#if SP_CELL_SIZE == 32
+#define SP_CELL_SHIFT 5
+#elif SP_CELL_SIZE == 64
+#define SP_CELL_SHIFT 6
+#endif
+
+#ifdef SP_CELL_SHIFT
+#define SP_CELL_OF(px) ((unsigned)(px) >> SP_CELL_SHIFT)  // cell of a pixel >= 0
+#else
+#define SP_CELL_OF(px) ((unsigned)(px) / SP_CELL_SIZE)
+#endif
+
+#define SP_GRID_COLS ((GFX_LCD_WIDTH + SP_CELL_SIZE - 1) / SP_CELL_SIZE)
+#define SP_GRID_ROWS ((GFX_LCD_HEIGHT + SP_CELL_SIZE - 1) / SP_CELL_SIZE)
+#define SP_OUT_OF_RANGE (SP_GRID_COLS * SP_GRID_ROWS)   // box of off-grid positions
+#define SP_MAX_CELLS (SP_OUT_OF_RANGE + 1)              // boxes in a multi_list_t
+#define SP_MASK_BYTES ((SP_MAX_CELLS + 7) / 8)          // bytes in a one-bit-per-box mask
+#define SP_LANES 2                                      // separately linked lanes per box
+
+/*
+Intrusive link into a timer_wheel_t (see wheel.h). Ticks count from 1, so a
+`due` of 0 means the timer isn't scheduled.
+*/
+typedef struct timer_link {
+    struct timer_link* prev;
+    struct timer_link* next;
+    uint24_t due;           // tick the timer fires on
+} timer_link_t;
+
+#define WHEEL_SLOTS 64      // must be a power of two
+
+typedef struct {
+    timer_link_t* slots[WHEEL_SLOTS];   // timers due on tick t are in slots[t % WHEEL_SLOTS]
+} timer_wheel_t;
+
+/*
+Timed effects are kept as the last game tick they apply to (game_t::tick), so
+nothing counts down while they run. Only the ones that have to act at some
+tick (DoT damage, regrow steps, the permafrost thaw) put the bloon's `timer`
+on game_t::bloon_timers, at the earliest of them.
+*/
 typedef struct bloon_t {
+    sp_link_t link;         // spatial partition links (must be first)
     position_t position;
     uint8_t type;           // bloon_type_t index into BLOON_DATA[]
     uint8_t modifiers;      // MOD_CAMO | MOD_REGROW bitmask
     int16_t hp;             // remaining HP for this layer
-    uint8_t regrow_timer;   // frames until next regrow tick
     uint8_t regrow_max;     // highest type this bloon can regrow to
-    uint16_t segment;       // current path segment index
-    int16_t progress;       // sub-pixel progress along segment (fixed-point x256)
-    uint8_t freeze_timer;   // frames remaining frozen (0 = not frozen)
-    uint8_t slow_timer;     // frames remaining slowed by glue (0 = not slowed)
-    uint8_t stun_timer;     // frames stunned (can't move)
+    uint16_t segment;       // path segment containing dist (num_points - 1 = past the end)
+    int24_t dist;           // distance along the path (fixed-point x256)
+    int24_t next_cross;     // dist at which it enters another grid box
+    uint24_t freeze_end;    // last tick frozen
+    uint24_t slow_end;      // last tick slowed by glue
+    uint24_t stun_end;      // last tick stunned (can't move)
+    uint24_t dot_next;      // tick of the next DoT damage (0 = no DoT)
+    uint24_t regrow_next;   // tick of the next regrow step (0 = not regrowing)
     uint8_t dot_damage;     // damage-over-time per tick
-    uint8_t dot_timer;      // frames remaining for DoT
     uint8_t dot_interval;   // frames between DoT ticks
-    uint8_t dot_tick;       // current tick countdown
+    uint8_t dot_left;       // DoT ticks still to come
     uint8_t frozen_by_permafrost; // was frozen by tower with permafrost
+    timer_link_t timer;     // on game_t::bloon_timers while anything above is pending
+    uint8_t track_slot;     // 1 + index in path_index_t::order (0 = not placed yet)
+    uint24_t serial;        // given when linked, never 0; tells a slot's bloons apart
 } bloon_t;
 
+/*
+Bloons sorted by distance along the path, grouped into PATH_BUCKET_SHIFT-sized
+buckets and by grid lane within a bucket; each lane of a bucket is itself in
+distance order. The order is kept from tick to tick and repaired once per
+tick by path_index_rebuild.
+*/
+typedef struct {
+    bloon_t** order;        // linked bloons by (bucket, lane, dist)
+    size_t count;           // entries in order at the last rebuild
+    size_t* start;          // lane k of bucket i starts at order[start[i * SP_LANES + k]]
+    size_t num_buckets;
+    size_t capacity;        // length of order
+} path_index_t;
+
+typedef struct {
+    int24_t from;           // distance along the path (fixed-point x256)
+    int24_t to;             // inclusive
+} path_span_t;
+
+#define TOWER_MAX_SPANS 4   // separate stretches of path one range circle can hold
+#define MAX_BLOON_TYPES 16  // bloon_type_t (bloons.h) values fit in the uint16_t type masks
+
 typedef struct {
     position_t position;
     uint8_t  type;              // tower_type_t
     uint8_t  upgrades[2];       // path 0 and 1 levels (0-4)
     uint8_t  target_mode;       // 0=FIRST 1=LAST 2=STRONG 3=CLOSE
     uint16_t cooldown;          // effective frames between attacks
-    uint16_t tick;              // frame counter
+    uint24_t next_fire;         // game tick of its next possible shot (0 = not scheduled yet)
     uint8_t  damage;            // effective damage
     uint8_t  pierce;            // effective pierce
     uint8_t  range;             // effective range pixels
@@ -90,28 +190,77 @@ typedef struct {
     uint8_t  distraction;       // chance to knock bloon back on hit
     uint8_t  glue_soak;         // glue applies to children on pop
     uint8_t  strips_camo;       // de-camo bloons on hit (Counter-Espionage)
+    uint8_t  num_spans;         // stretches of path inside the range circle
+    path_span_t spans[TOWER_MAX_SPANS]; // ascending and in separate buckets
+    uint16_t hit_types;         // bit t set if damage_type can hurt bloon type t
+    int16_t  damage_vs[MAX_BLOON_TYPES]; // damage one hit does to each bloon type (-1 = immune)
+    uint8_t  target_slot;       // First/Last target from the last scan: its bloon_pool slot
+    uint24_t target_serial;     // and serial (0 = none)
+    uint8_t  target_shots;      // times it was reused since that scan
 } tower_t;
 
+/*
+Towers as a binary min-heap on next_fire (items[0] fires first). It is rebuilt
+whenever towers are placed, sold, upgraded or loaded; between those, each tick
+only touches the towers that are due. A tower whose range holds no bloons when
+it comes due is taken off until a bloon enters one of its path buckets.
+*/
+typedef struct {
+    tower_t** items;
+    size_t count;
+    size_t capacity;        // length of items
+} tower_heap_t;
+
+/*
+Only per-shot state lives here. Speed, damage, sprite and every ability
+(splash, homing, stun, DoT, camo) are read through `owner`, which acts as the
+shared archetype for all of that tower's shots.
+*/
 typedef struct {
+    sp_link_t link;             // spatial partition links (must be first)
     position_t position;
-    gfx_sprite_t* sprite;
-    uint8_t speed;
+    position_t from;            // position before this tick's move (swept for hits)
+    tower_t* owner;             // tower that fired this (never NULL)
     uint8_t angle;              // 0-255 LUT angle
-    uint8_t pierce;
-    uint8_t damage;
-    uint8_t damage_type;        // damage_type_t bitmask
+    uint8_t pierce;             // bloons left to hit
     uint8_t lifetime;           // frames remaining before despawn
-    void* owner;                // tower_t* that fired this (for pop count)
-    uint8_t splash_radius;      // 0 = no splash, >0 = damage all bloons within radius
-    uint8_t is_homing;          // 1 = seeks nearest bloon each frame
-    uint8_t stun_duration;      // frames to stun bloon on hit
-    uint8_t can_see_camo;       // projectile can hit camo
-    uint8_t dot_damage;         // DoT to apply on hit (glue)
-    uint8_t dot_interval;       // DoT tick interval to apply
-    uint8_t glue_soak;          // glue applies to children
-    uint8_t strips_camo;        // de-camo bloons on hit
 } projectile_t;
 
+/*
+What is in one grid box of bloons, so a query can reject the whole box without
+walking it. The counts are exact at all times; `types` only grows until
+updateBloons rebuilds it each tick, so it may over-report.
+*/
+typedef struct {
+    uint8_t camo;           // camo bloons in the box
+    uint8_t plain;          // non-camo bloons in the box
+    uint16_t types;         // bit t set if a bloon of type t may be in the box
+} bloon_cell_t;
+
+/*
+Something that happened to a bloon during a tick. The passes that walk the
+grids only record these; they are acted on in one batch at the end of the
+tick, so nothing spawns into or leaves a box while it is being walked.
+*/
+typedef enum {
+    EVENT_POP,              // `bloon` ran out of hp: pop it into its children
+    EVENT_LEAK,             // `bloon` reached the end of the path, costing `amount` hearts
+} event_kind_t;
+
+typedef struct {
+    uint8_t kind;           // event_kind_t
+    int16_t amount;
+    bloon_t* bloon;         // pool slot; valid until the end of the tick
+    tower_t* tower;         // NULL if no tower was involved
+} game_event_t;
+
+typedef struct {
+    game_event_t* items;
+    size_t count;
+    size_t capacity;
+    size_t high_water;      // most events in one tick
+} event_queue_t;
+
 typedef struct {
     uint8_t group_index;    // which group in this round we're spawning
     uint16_t spawned;       // how many spawned in current group
@@ -120,16 +269,16 @@ typedef struct {
 } round_state_t;
 
 typedef struct {
-    size_t width;               // width of space in terms of `box_size`
-    size_t height;              // height of the space in terms of `box_size`
-    size_t box_size;            // size of the squares we break the space into
-    size_t num_boxes_in_range;  // width * height
-    queue_t** boxes;            // boxes which collectively contain all inserted
-    size_t n;                   // length of boxes
+    size_t n;                   // number of boxes (in range + out-of-range)
     size_t total_size;          // number of elements across all boxes
-    queue_t* inited_boxes;  // since boxes are lazily calculated, this contains
-                            // only the ones which have been actually inited;
-                            // contains a pointer to box (which is a list)
+    uint8_t occupied[SP_MASK_BYTES];  // bit b set <=> box b is non-empty
+#ifdef SP_REBUILD
+    sp_link_t** order;          // linked elements grouped by box (sp_rebuild)
+    size_t order_cap;           // length of order
+    size_t* start;              // lane k of box i starts at order[start[i * SP_LANES + k]]
+#else
+    sp_box_t* boxes;            // lane k of box i is boxes[i * SP_LANES + k]
+#endif
 } multi_list_t;
 
 typedef enum {
@@ -161,8 +310,22 @@ typedef struct game_t_tag {
     int16_t hearts;
     int24_t coins;
     queue_t* towers;
+    tower_heap_t tower_schedule;    // every tower, by when it can next fire
+    queue_t* aura_towers;   // towers with has_aura, which act every tick (not owned)
+    queue_t* sleeping_towers;   // towers off the schedule until a bloon enters their range (not owned)
+    uint8_t* tower_watch;   // per bloon_track bucket: sleeping towers whose range covers it
     multi_list_t* bloons;
+    pool_t bloon_pool;      // dense storage for everything linked into bloons
+    bloon_cell_t bloon_cells[SP_MAX_CELLS]; // summary of each box of bloons
+    path_index_t bloon_track;   // bloons bucketed by distance along the path
     multi_list_t* projectiles;
+    pool_t projectile_pool; // dense storage for everything linked into projectiles
+    event_queue_t events;   // this tick's pops and leaks
+    uint24_t tick;          // simulation steps so far (the first one is tick 1)
+    uint24_t bloon_serial;  // serial of the last bloon linked
+    uint24_t target_reuses; // First/Last targets taken from a tower's cache
+    uint24_t target_scans;  // and found by a full scan
+    timer_wheel_t bloon_timers; // bloons with a DoT, regrow or thaw coming up
     round_state_t round_state;
     bool exit;
     cursor_type_t cursor_type;
@@ -0,0 +1,62 @@
+#include "tower_heap.h"
+
+#include "utils.h"
+
+/* Move items[i] down until neither child is due before it */
+static void sift_down(tower_heap_t *h, size_t i) {
+    tower_t *t = h->items[i];
+    for (;;) {
+        size_t c = 2 * i + 1;
+        if (c >= h->count) break;
+        if (c + 1 < h->count && h->items[c + 1]->next_fire < h->items[c]->next_fire) c++;
+        if (h->items[c]->next_fire >= t->next_fire) break;
+        h->items[i] = h->items[c];
+        i = c;
+    }
+    h->items[i] = t;
+}
+
+void tower_heap_build(tower_heap_t *h, queue_t *towers) {
+    if (h->capacity < towers->size) {
+        free(h->items);
+        h->items = safe_malloc(sizeof(tower_t *) * towers->size, __LINE__);
+        h->capacity = towers->size;
+    }
+
+    h->count = 0;
+    for (list_ele_t *e = towers->head; e != NULL; e = e->next) {
+        h->items[h->count++] = e->value;
+    }
+
+    // heapify bottom-up
+    for (size_t i = h->count / 2; i-- > 0;) sift_down(h, i);
+}
+
+void tower_heap_sift_top(tower_heap_t *h) {
+    if (h->count > 1) sift_down(h, 0);
+}
+
+void tower_heap_push(tower_heap_t *h, tower_t *t) {
+    // move parents down until one is due no later than t
+    size_t i = h->count++;
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (h->items[parent]->next_fire <= t->next_fire) break;
+        h->items[i] = h->items[parent];
+        i = parent;
+    }
+    h->items[i] = t;
+}
+
+void tower_heap_pop(tower_heap_t *h) {
+    if (h->count == 0) return;
+    h->items[0] = h->items[--h->count];
+    if (h->count > 1) sift_down(h, 0);
+}
+
+void tower_heap_free(tower_heap_t *h) {
+    free(h->items);
+    h->items = NULL;
+    h->count = 0;
+    h->capacity = 0;
+}
@@ -0,0 +1,37 @@
+#ifndef TOWER_HEAP_H
+#define TOWER_HEAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdlib.h>
+
+#include "list.h"
+#include "structs.h"
+
+/// @brief Refill the heap with every tower in `towers`, keyed on next_fire
+void tower_heap_build(tower_heap_t *h, queue_t *towers);
+
+/// @brief Restore the heap after the first tower's next_fire moved later
+void tower_heap_sift_top(tower_heap_t *h);
+
+/// @brief Add a tower (the heap never holds more than were last built from)
+void tower_heap_push(tower_heap_t *h, tower_t *t);
+
+/// @brief Remove the first tower
+void tower_heap_pop(tower_heap_t *h);
+
+/// @brief Free the heap's storage (the towers belong to the tower list)
+void tower_heap_free(tower_heap_t *h);
+
+/// @brief The tower due to fire first, or `NULL` if there are none
+static inline tower_t *tower_heap_top(const tower_heap_t *h) {
+    return h->count > 0 ? h->items[0] : NULL;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,55 @@
+#include "wheel.h"
+
+#include <string.h>
+
+static inline timer_link_t **wheel_slot(timer_wheel_t *w, uint24_t due) {
+    return &w->slots[due & (WHEEL_SLOTS - 1)];
+}
+
+void wheel_init(timer_wheel_t *w) { memset(w->slots, 0, sizeof(w->slots)); }
+
+void wheel_cancel(timer_wheel_t *w, timer_link_t *t) {
+    // NO-OP if it isn't scheduled
+    if (t->due == 0) return;
+
+    if (t->prev != NULL) {
+        t->prev->next = t->next;
+    } else {
+        *wheel_slot(w, t->due) = t->next;
+    }
+    if (t->next != NULL) t->next->prev = t->prev;
+    t->due = 0;
+}
+
+void wheel_schedule(timer_wheel_t *w, timer_link_t *t, uint24_t due) {
+    wheel_cancel(w, t);
+
+    timer_link_t **slot = wheel_slot(w, due);
+    t->due = due;
+    t->prev = NULL;
+    t->next = *slot;
+    if (*slot != NULL) (*slot)->prev = t;
+    *slot = t;
+}
+
+void wheel_relink(timer_wheel_t *w, timer_link_t *t) {
+    if (t->due == 0) return;
+
+    if (t->prev != NULL) {
+        t->prev->next = t;
+    } else {
+        *wheel_slot(w, t->due) = t;
+    }
+    if (t->next != NULL) t->next->prev = t;
+}
+
+timer_link_t *wheel_expire(timer_wheel_t *w, uint24_t now) {
+    for (timer_link_t *t = *wheel_slot(w, now); t != NULL; t = t->next) {
+        // the rest of the slot is for a later lap
+        if (t->due > now) continue;
+
+        wheel_cancel(w, t);
+        return t;
+    }
+    return NULL;
+}
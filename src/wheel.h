@@ -0,0 +1,45 @@
+#ifndef WHEEL_H
+#define WHEEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "structs.h"
+
+/* A hashed timing wheel: a timer due on tick `t` waits in slot
+ * t % WHEEL_SLOTS, and each tick only that slot is looked at. Timers more
+ * than WHEEL_SLOTS ticks out just stay put for another lap.
+ *
+ *     timer_link_t *t;
+ *     while ((t = wheel_expire(w, now)) != NULL) { ... maybe reschedule t ... }
+ */
+
+/// @brief Empty every slot
+void wheel_init(timer_wheel_t *w);
+
+/// @brief (Re)schedule `t` for tick `due`, which must be after the current one
+void wheel_schedule(timer_wheel_t *w, timer_link_t *t, uint24_t due);
+
+/// @brief Take `t` off the wheel (NO-OP if it isn't on it)
+void wheel_cancel(timer_wheel_t *w, timer_link_t *t);
+
+/// @brief Point `t`'s neighbours back at it after its owner was moved in
+/// memory (e.g. by sp_compact)
+void wheel_relink(timer_wheel_t *w, timer_link_t *t);
+
+/// @brief Take the next timer due at or before `now` out of now's slot
+/// @return `NULL` once there are none left
+timer_link_t *wheel_expire(timer_wheel_t *w, uint24_t now);
+
+/// @brief Is `t` on the wheel?
+static inline bool wheel_scheduled(const timer_link_t *t) { return t->due != 0; }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif